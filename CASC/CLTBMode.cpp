@@ -48,6 +48,7 @@
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 
+#include "Parse/ParallelTPTP.hpp"
 #include "Parse/TPTP.hpp"
 
 #include "Schedules.hpp"
@@ -256,19 +257,19 @@ void CLTBMode::loadIncludes()
     TimeCounter tc(TC_PARSING);
     env.statistics->phase=Statistics::PARSING;
 
+    Stack<vstring> fileNames;
     StringList::Iterator iit(_theoryIncludes);
     while (iit.hasNext()) {
-      vstring fname=env.options->includeFileName(iit.next());
+      fileNames.push(env.options->includeFileName(iit.next()));
+    }
+    // the axiom files are independent, so they are parsed by forked workers
+    Parse::ParallelTPTP parser(fileNames);
+    parser.parse();
 
-      ifstream inp(fname.c_str());
-      if (inp.fail()) {
-        USER_ERROR("Cannot open included file: "+fname);
-      }
-      Parse::TPTP parser(inp);
-      parser.parse();
-      UnitList* funits = parser.units();
-      if (parser.containsConjecture()) {
-	USER_ERROR("Axiom file " + fname + " contains a conjecture.");
+    for (unsigned i=0;i<fileNames.size();i++) {
+      UnitList* funits = parser.units(i);
+      if (parser.containsConjecture(i)) {
+	USER_ERROR("Axiom file " + fileNames[i] + " contains a conjecture.");
       }
 
       UnitList::Iterator fuit(funits);
@@ -283,6 +284,11 @@ void CLTBMode::loadIncludes()
   //ensure we scan the theory axioms for property here, so we don't need to
   //do it afterward in each problem
   _baseProblem->getProperty();
+
+  //the structure is built once here and inherited by the forked processes
+  //of all problems, so that their slices only select from it
+  _theorySelector = new Shell::SineTheorySelector(*env.options);
+  _theorySelector->initSelectionStructure(theoryAxioms);
   env.statistics->phase=Statistics::UNKNOWN_PHASE;
 } // CLTBMode::loadIncludes
 
@@ -1001,17 +1007,12 @@ void CLTBProblem::runSlice(Options& strategyOpt)
   opt.setProblemName(problemFile);
   *env.options = opt; //just temporarily until we get rid of dependencies on env.options in solving
 
-//  if (env.options->sineSelection()!=Options::SS_OFF) {
-//    //add selected axioms from the theory
-//    parent->theorySelector.perform(probUnits);
-//
-//    env.options->setSineSelection(Options::SS_OFF);
-//    env.options->forceIncompleteness();
-//  }
-//  else {
-//    //if there wasn't any sine selection, just put in all theory axioms
-//    probUnits=UnitList::concat(probUnits, parent->theoryAxioms);
-//  }
+  if (parent->_theorySelector->canPerform(opt)) {
+    //select the theory axioms using the structure built for the whole batch
+    parent->_theorySelector->perform(prb, opt);
+    opt.setSineSelection(Options::SineSelection::OFF);
+    *env.options = opt;
+  }
 
   env.beginOutput();
   CLTBMode::lineOutput() << opt.testId() << " on " << opt.problemName() << endl;
@@ -111,6 +111,9 @@ private:
 
   ScopedPtr<Problem> _baseProblem;
 
+  /** SInE selection structure over the theory axioms in @b _baseProblem */
+  ScopedPtr<Shell::SineTheorySelector> _theorySelector;
+
   // This contains formulas 'learned' in the sense that they were input
   // formulas used in proofs of previous problems
   // Note: this relies on the assurance that formulas are consistently named
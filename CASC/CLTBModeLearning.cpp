@@ -49,6 +49,7 @@
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 
+#include "Parse/ParallelTPTP.hpp"
 #include "Parse/TPTP.hpp"
 
 #include "CLTBModeLearning.hpp"
@@ -284,19 +285,19 @@ void CLTBModeLearning::loadIncludes()
     TimeCounter tc(TC_PARSING);
     env.statistics->phase=Statistics::PARSING;
 
+    Stack<vstring> fileNames;
     StringList::Iterator iit(_theoryIncludes);
     while (iit.hasNext()) {
-      vstring fname=env.options->includeFileName(iit.next());
+      fileNames.push(env.options->includeFileName(iit.next()));
+    }
+    // the axiom files are independent, so they are parsed by forked workers
+    Parse::ParallelTPTP parser(fileNames);
+    parser.parse();
 
-      ifstream inp(fname.c_str());
-      if (inp.fail()) {
-        USER_ERROR("Cannot open included file: "+fname);
-      }
-      Parse::TPTP parser(inp);
-      parser.parse();
-      UnitList* funits = parser.units();
-      if (parser.containsConjecture()) {
-	USER_ERROR("Axiom file " + fname + " contains a conjecture.");
+    for (unsigned i=0;i<fileNames.size();i++) {
+      UnitList* funits = parser.units(i);
+      if (parser.containsConjecture(i)) {
+	USER_ERROR("Axiom file " + fileNames[i] + " contains a conjecture.");
       }
 
       UnitList::Iterator fuit(funits);
@@ -32,11 +32,16 @@
 #include "Lib/Sys/Multiprocessing.hpp"
 
 #include "Shell/Options.hpp"
+#include "Shell/Preprocess.hpp"
+#include "Shell/ProblemCache.hpp"
 #include "Shell/Statistics.hpp"
 #include "Shell/UIHelper.hpp"
 #include "Shell/Normalisation.hpp"
 #include "Shell/TheoryFinder.hpp"
 
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <unistd.h>
 
 #include "Saturation/ProvingHelper.hpp"
@@ -50,7 +55,7 @@
 using namespace Lib;
 using namespace CASC;
 
-PortfolioMode::PortfolioMode() : _slowness(1.0), _syncSemaphore(2) {
+PortfolioMode::PortfolioMode() : _slowness(1.0), _snapshotCnt(0), _syncSemaphore(2) {
   // We need the following two values because the way the semaphore class is currently implemented:
   // 1) dec is the only operation which is blocking
   // 2) dec is done in the mode SEM_UNDO, so is undone when a process terminates
@@ -357,16 +362,15 @@ static unsigned milliToDeci(unsigned timeInMiliseconds) {
 // Simple one-after-the-other priority.
 float PortfolioProcessPriorityPolicy::staticPriority(vstring sliceCode)
 {
-  static float priority = 0.;
-  priority += 1.;
-  return priority;
+  _lastPriority += 1.;
+  return _lastPriority;
 }
 
-//should never be called
-float PortfolioProcessPriorityPolicy::dynamicPriority(pid_t pid)
+// A suspended slice goes after every slice that is already queued.
+float PortfolioProcessPriorityPolicy::dynamicPriority(pid_t pid, const Lib::Sys::ProgressRecord& progress)
 {
-  ASSERTION_VIOLATION;
-  return 0.;
+  _lastPriority += 1.;
+  return _lastPriority;
 }
 
 PortfolioSliceExecutor::PortfolioSliceExecutor(PortfolioMode *mode)
@@ -412,11 +416,21 @@ bool PortfolioMode::runSchedule(Schedule& schedule, int terminationTime)
 
   UIHelper::portfolioParent = true; // to report on overall-solving-ended in Timer.cpp
 
+  if (env.options->sharedPreprocessing()) {
+    countPreprocessingKeys(schedule);
+    if (_sharedKeys.size() && !createSnapshotDir()) {
+      //every slice preprocesses the problem on its own
+      _sharedKeys.reset();
+    }
+  }
+
   PortfolioProcessPriorityPolicy policy;
   PortfolioSliceExecutor executor(this);
   ScheduleExecutor sched(&policy, &executor);
 
-  return sched.run(schedule, terminationTime);
+  bool result = sched.run(schedule, terminationTime);
+  removePreprocessedSnapshots();
+  return result;
 }
 
 /**
@@ -441,6 +455,190 @@ unsigned PortfolioMode::getSliceTime(vstring sliceCode,vstring& chopped)
   return time;
 } // getSliceTime
 
+/**
+ * Return the preprocessing key of a slice with options @b sliceOpt, or
+ * the empty string if the slice must preprocess the problem on its own.
+ *
+ * Finite model building and answer literals keep state about the problem
+ * that the problem cache does not store, so slices using either of them
+ * always preprocess the problem on their own.
+ */
+vstring PortfolioMode::getPreprocessingKey(const Options& sliceOpt)
+{
+  CALL("PortfolioMode::getPreprocessingKey/1");
+
+  if (sliceOpt.saturationAlgorithm() == Options::SaturationAlgorithm::FINITE_MODEL_BUILDING ||
+      sliceOpt.questionAnswering() != Options::QuestionAnsweringMode::OFF) {
+    return "";
+  }
+  return sliceOpt.generatePreprocessingKey();
+}
+
+/**
+ * Assign to @b opt the options with which the slice @b sliceCode will run.
+ *
+ * This is called in the parent process, so warnings about unknown options
+ * are suppressed; the child reports them when it reads the same code.
+ */
+void PortfolioMode::getSliceOptions(vstring sliceCode, Options& opt)
+{
+  CALL("PortfolioMode::getSliceOptions");
+
+  opt = *env.options;
+  opt.setIgnoreMissing(Options::IgnoreMissing::ON);
+  opt.readFromEncodedOptions(sliceCode);
+  //the same adjustments as in runSlice(Options&)
+  opt.setNormalize(false);
+  opt.setForcedOptionValues();
+}
+
+/**
+ * Return the preprocessing key of the slice given by its code
+ */
+vstring PortfolioMode::getPreprocessingKey(vstring sliceCode)
+{
+  CALL("PortfolioMode::getPreprocessingKey/2");
+
+  Options opt;
+  getSliceOptions(sliceCode, opt);
+  return getPreprocessingKey(opt);
+}
+
+/**
+ * Count how many slices of @b schedule share each preprocessing key and
+ * number the keys shared by more than one slice.
+ */
+void PortfolioMode::countPreprocessingKeys(Schedule& schedule)
+{
+  CALL("PortfolioMode::countPreprocessingKeys");
+
+  _preprocessingKeyCounts.reset();
+  _sharedKeys.reset();
+
+  Schedule::Iterator it(schedule);
+  while (it.hasNext()) {
+    vstring key = getPreprocessingKey(it.next());
+    if (key.empty()) {
+      continue;
+    }
+    unsigned* cnt;
+    _preprocessingKeyCounts.getValuePtr(key, cnt, 0);
+    (*cnt)++;
+    if (*cnt == 2) {
+      _sharedKeys.insert(key, _snapshotCnt++);
+    }
+  }
+}
+
+/**
+ * Return the name of the file with the problem preprocessed for the slices
+ * with options @b sliceOpt, or the empty string if the slice preprocesses
+ * the problem on its own.
+ *
+ * The file is in the private directory created by the parent before the
+ * slices were started, so the name is the same in all slices.
+ */
+vstring PortfolioMode::getPreprocessedSnapshot(const Options& sliceOpt)
+{
+  CALL("PortfolioMode::getPreprocessedSnapshot");
+
+  if (!sliceOpt.sharedPreprocessing()) {
+    return "";
+  }
+  vstring key = getPreprocessingKey(sliceOpt);
+  unsigned index;
+  if (key.empty() || !_sharedKeys.find(key, index)) {
+    return "";
+  }
+  return getSnapshotName(index);
+}
+
+vstring PortfolioMode::getSnapshotName(unsigned index)
+{
+  ASS(!_snapshotDir.empty());
+  return _snapshotDir+"/"+Int::toString(index);
+}
+
+/**
+ * Create the private directory for the files with preprocessed problems,
+ * return false if it cannot be created
+ *
+ * The directory is accessible only to the current user and its name is
+ * unpredictable, so other users cannot plant or replace files in it.
+ */
+bool PortfolioMode::createSnapshotDir()
+{
+  CALL("PortfolioMode::createSnapshotDir");
+  ASS(_snapshotDir.empty());
+
+  char dirName[]="/tmp/vampire_pp_XXXXXX";
+  if (!mkdtemp(dirName)) {
+    if (outputAllowed()) {
+      env.beginOutput();
+      addCommentSignForSZS(env.out());
+      env.out()<<"Cannot create a directory for shared preprocessing: "<<strerror(errno)<<endl;
+      env.endOutput();
+    }
+    return false;
+  }
+  _snapshotDir=dirName;
+  return true;
+}
+
+/**
+ * Remove the directory with the files with preprocessed problems of the
+ * last schedule, together with anything the slices left in it (e.g.
+ * temporary files of slices killed while saving)
+ */
+void PortfolioMode::removePreprocessedSnapshots()
+{
+  CALL("PortfolioMode::removePreprocessedSnapshots");
+
+  _sharedKeys.reset();
+  if (_snapshotDir.empty()) {
+    return;
+  }
+  Stack<vstring> files;
+  System::readDir(_snapshotDir, files);
+  Stack<vstring>::Iterator fit(files);
+  while (fit.hasNext()) {
+    remove(fit.next().c_str());
+  }
+  rmdir(_snapshotDir.c_str());
+  _snapshotDir="";
+}
+
+/**
+ * Run the proof search of the slice with options @b opt on the problem.
+ *
+ * If the slice shares its preprocessing with other slices, the problem
+ * preprocessed by the first of them is loaded from a file. If the file
+ * does not exist yet, this slice preprocesses the problem and stores it.
+ * All the slices start from the same parsed problem and the same signature,
+ * so the loaded problem is the one the slice would have obtained itself.
+ */
+void PortfolioMode::runProblem(const Options& opt)
+{
+  CALL("PortfolioMode::runProblem");
+
+  vstring snapshot = getPreprocessedSnapshot(opt);
+  if (snapshot.empty()) {
+    Saturation::ProvingHelper::runVampire(*_prb, opt);
+    return;
+  }
+
+  Problem* preprocessed;
+  {
+    TimeCounter tc(TC_PREPROCESSING);
+    preprocessed = ProblemCache::load(snapshot, false);
+  }
+  if (preprocessed) {
+    Saturation::ProvingHelper::runVampireSaturation(*preprocessed, opt);
+    return;
+  }
+  Saturation::ProvingHelper::runVampire(*_prb, opt, snapshot);
+}
+
 /**
  * Wait for termination of a child
  * return true if a proof was found
@@ -522,7 +720,7 @@ void PortfolioMode::runSlice(Options& strategyOpt)
     env.endOutput();
   }
 
-  Saturation::ProvingHelper::runVampire(*_prb, opt);
+  runProblem(opt);
 
   //set return value to zero if we were successful
   if (env.statistics->terminationReason == Statistics::REFUTATION ||
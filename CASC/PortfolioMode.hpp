@@ -26,6 +26,7 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/DHMap.hpp"
 #include "Lib/Portability.hpp"
 #include "Lib/ScopedPtr.hpp"
 #include "Lib/Set.hpp"
@@ -51,8 +52,12 @@ class PortfolioMode;
 class PortfolioProcessPriorityPolicy : public ProcessPriorityPolicy
 {
 public:
+  PortfolioProcessPriorityPolicy() : _lastPriority(0.) {}
   float staticPriority(vstring sliceCode) override;
-  float dynamicPriority(pid_t pid) override;
+  float dynamicPriority(pid_t pid, const Lib::Sys::ProgressRecord& progress) override;
+
+private:
+  float _lastPriority;
 };
 
 class PortfolioSliceExecutor : public SliceExecutor
@@ -91,6 +96,16 @@ private:
   void runSlice(vstring slice, unsigned timeLimitInDeciseconds) NO_RETURN;
   void runSlice(Options& strategyOpt) NO_RETURN;
 
+  void getSliceOptions(vstring sliceCode, Options& opt);
+  static vstring getPreprocessingKey(const Options& sliceOpt);
+  vstring getPreprocessingKey(vstring sliceCode);
+  void countPreprocessingKeys(Schedule& schedule);
+  vstring getPreprocessedSnapshot(const Options& sliceOpt);
+  vstring getSnapshotName(unsigned index);
+  bool createSnapshotDir();
+  void removePreprocessedSnapshots();
+  void runProblem(const Options& opt);
+
 #if VDEBUG
   DHSet<pid_t> childIds;
 #endif
@@ -105,6 +120,22 @@ private:
    */
   ScopedPtr<Problem> _prb;
 
+  /** Number of slices of the current schedule with a given preprocessing key */
+  DHMap<vstring,unsigned> _preprocessingKeyCounts;
+  /**
+   * Preprocessing keys shared by several slices of the current schedule,
+   * mapped to the number of the file with their preprocessed problem
+   * (see the shared_preprocessing option)
+   */
+  DHMap<vstring,unsigned> _sharedKeys;
+  /**
+   * Private directory with the files with preprocessed problems of the
+   * current schedule, empty if there is none
+   */
+  vstring _snapshotDir;
+  /** Number of files with preprocessed problems assigned so far */
+  unsigned _snapshotCnt;
+
   Semaphore _syncSemaphore; // semaphore for synchronizing proof printing
 };
 
@@ -0,0 +1,336 @@
+/*
+ * File SATPortfolioMode.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SATPortfolioMode.cpp
+ * Implements class SATPortfolioMode.
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <sys/mman.h>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Random.hpp"
+#include "Lib/System.hpp"
+#include "Lib/Timer.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+
+#include "SAT/LingelingInterfacing.hpp"
+#include "SAT/MinisatInterfacing.hpp"
+#include "SAT/MinisatInterfacingNewSimp.hpp"
+#include "SAT/TWLSolver.hpp"
+
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
+
+#include "SATPortfolioMode.hpp"
+
+using namespace CASC;
+using namespace Lib::Sys;
+using namespace Shell;
+
+/** Conflict limit of the first solving round of every worker */
+#define INITIAL_CONFLICT_LIMIT 2000
+
+/**
+ * Solve the propositional problem given by @b clauses over variables
+ * 1..@b varCnt by a portfolio of SAT solvers
+ */
+SATSolver::Status SATPortfolioMode::solve(SATClauseList* clauses, unsigned varCnt)
+{
+  CALL("SATPortfolioMode::solve");
+
+  SATPortfolioMode mode(clauses, varCnt, getNumWorkers());
+  return mode.run();
+}
+
+SATPortfolioMode::SATPortfolioMode(SATClauseList* clauses, unsigned varCnt, unsigned workerCnt)
+: _clauses(clauses), _varCnt(varCnt), _workerCnt(workerCnt), _index(0), _cursors(workerCnt)
+{
+  CALL("SATPortfolioMode::SATPortfolioMode");
+  ASS_G(workerCnt,0);
+
+  void* mem = mmap(0, workerCnt*sizeof(WorkerRecord), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if(mem==MAP_FAILED) {
+    SYSTEM_FAIL("Call to mmap() failed when creating SAT portfolio.",errno);
+  }
+  //anonymous mappings are zero-filled
+  _records = static_cast<WorkerRecord*>(mem);
+  _cursors.init(workerCnt, 0);
+}
+
+SATPortfolioMode::~SATPortfolioMode()
+{
+  CALL("SATPortfolioMode::~SATPortfolioMode");
+
+  munmap(_records, _workerCnt*sizeof(WorkerRecord));
+}
+
+unsigned SATPortfolioMode::getNumWorkers()
+{
+  CALL("SATPortfolioMode::getNumWorkers");
+
+  unsigned cores = System::getNumberOfCores();
+  cores = cores < 1 ? 1 : cores;
+  unsigned workers = env.options->multicore();
+  if(!workers || workers>cores) {
+    workers = cores;
+  }
+  return workers;
+}
+
+/**
+ * Fork the workers and wait for the first one to solve the problem
+ */
+SATSolver::Status SATPortfolioMode::run()
+{
+  CALL("SATPortfolioMode::run");
+
+  DArray<pid_t> workers(_workerCnt);
+  for(unsigned i=0; i<_workerCnt; i++) {
+    pid_t pid = Multiprocessing::instance()->fork();
+    ASS_NEQ(pid, -1);
+    if(!pid) {
+      runWorker(i);
+    }
+    workers[i] = pid;
+  }
+
+  SATSolver::Status res = SATSolver::UNKNOWN;
+  unsigned running = _workerCnt;
+  while(running) {
+    int exitCode;
+    pid_t pid = Multiprocessing::instance()->waitForChildTermination(exitCode);
+    running--;
+    if(exitCode) {
+      continue;
+    }
+    for(unsigned i=0; i<_workerCnt; i++) {
+      if(workers[i]==pid) {
+        res = static_cast<SATSolver::Status>(_records[i].status);
+        break;
+      }
+    }
+    break;
+  }
+
+  for(unsigned i=0; i<_workerCnt; i++) {
+    Multiprocessing::instance()->killNoCheck(workers[i], SIGKILL);
+  }
+  while(running) {
+    int exitCode;
+    Multiprocessing::instance()->waitForChildTermination(exitCode);
+    running--;
+  }
+  return res;
+}
+
+/**
+ * Create the solver of the worker with index @b index and set @b canImport
+ * to false if units cannot be added to it after the solving started.
+ * Options specific to the worker are set in @b opt.
+ *
+ * The first worker uses the solver selected by the sat_solver option,
+ * the others cycle through the available solvers and restart strategies.
+ */
+SATSolver* SATPortfolioMode::createWorkerSolver(unsigned index, Options& opt, bool& canImport)
+{
+  CALL("SATPortfolioMode::createWorkerSolver");
+
+  // variables eliminated by the simplification of MinisatInterfacingNewSimp
+  // cannot occur in clauses added later
+  canImport = true;
+  if(index==0) {
+    switch(opt.satSolver()) {
+    case Options::SatSolver::VAMPIRE:
+      return new TWLSolver(opt);
+    case Options::SatSolver::MINISAT:
+      canImport = false;
+      return new MinisatInterfacingNewSimp(opt);
+    case Options::SatSolver::LINGELING:
+      return new LingelingInterfacing(opt);
+    default:
+      // Z3 is not a plain SAT solver, Minisat takes its place as in InstGen
+      return new MinisatInterfacing(opt);
+    }
+  }
+
+  switch((index-1)%6) {
+  case 0:
+    opt.setSatRestartStrategy(Options::SatRestartStrategy::LUBY);
+    return new TWLSolver(opt);
+  case 1:
+    return new MinisatInterfacing(opt);
+  case 2:
+    opt.setSatRestartStrategy(Options::SatRestartStrategy::MINISAT);
+    return new TWLSolver(opt);
+  case 3:
+    return new LingelingInterfacing(opt);
+  case 4:
+    canImport = false;
+    return new MinisatInterfacingNewSimp(opt);
+  default:
+    ASS_EQ((index-1)%6, 5);
+    opt.setSatRestartStrategy(Options::SatRestartStrategy::GEOMETRIC);
+    return new TWLSolver(opt);
+  }
+}
+
+/**
+ * Solve the problem in the worker process with index @b index, exit with zero
+ * status after storing the result to the shared memory
+ *
+ * Workers print nothing. The parent enforces the time limit and reports
+ * the result, and a worker that fails just exits with nonzero status.
+ */
+void SATPortfolioMode::runWorker(unsigned index)
+{
+  CALL("SATPortfolioMode::runWorker");
+
+  // die quietly with the parent rather than report the signal
+  signal(SIGHUP, SIG_DFL);
+  System::registerForSIGHUPOnParentDeath();
+  Timer::setTimeLimitEnforcement(false);
+
+  try {
+    solveInWorker(index);
+  }
+  catch(...) {
+  }
+  System::terminateImmediately(1);
+}
+
+/**
+ * The proof search of the worker with index @b index, which terminates
+ * the process once the problem is solved
+ */
+void SATPortfolioMode::solveInWorker(unsigned index)
+{
+  CALL("SATPortfolioMode::solveInWorker");
+
+  _index = index;
+  Random::setSeed(env.options->randomSeed()+index);
+
+  static Options opt;
+  opt = *env.options;
+  bool canImport;
+  SATSolverSCP solver(createWorkerSolver(index, opt, canImport));
+
+  solver->ensureVarCount(_varCnt);
+  solver->addClausesIter(pvi(SATClauseList::Iterator(_clauses)));
+
+  DArray<bool> published(_varCnt+1);
+  published.init(_varCnt+1, false);
+  static SATLiteralStack units;
+
+  unsigned conflictLimit = INITIAL_CONFLICT_LIMIT;
+  for(;;) {
+    SATSolver::Status status = solver->solve(conflictLimit);
+    if(status!=SATSolver::UNKNOWN) {
+      _records[index].status = status;
+      System::terminateImmediately(0);
+    }
+
+    publish(*solver, published);
+
+    if(canImport) {
+      units.reset();
+      collect(units);
+      while(units.isNonEmpty()) {
+        SATLiteral lit = units.pop();
+        if(solver->isZeroImplied(lit.var())) {
+          continue;
+        }
+        // there is no point in publishing the unit back
+        published[lit.var()] = true;
+        static SATLiteralStack unitLits;
+        unitLits.reset();
+        unitLits.push(lit);
+        solver->addClause(SATClause::fromStack(unitLits));
+      }
+    }
+
+    conflictLimit += conflictLimit/2;
+  }
+}
+
+/**
+ * Publish the zero-implied literals of @b solver that were not published
+ * yet by the current worker and mark them in @b published
+ */
+void SATPortfolioMode::publish(SATSolver& solver, DArray<bool>& published)
+{
+  CALL("SATPortfolioMode::publish");
+
+  static SATLiteralStack zeroImplied;
+  zeroImplied.reset();
+  solver.collectZeroImplied(zeroImplied);
+
+  WorkerRecord& rec = _records[_index];
+  unsigned cnt = rec.published;
+
+  SATLiteralStack::BottomFirstIterator it(zeroImplied);
+  while(it.hasNext()) {
+    SATLiteral lit = it.next();
+    if(published[lit.var()]) {
+      continue;
+    }
+    published[lit.var()] = true;
+    // a reader that sees the overwritten slot must also see the count
+    // published before it, so that it can detect the overwrite
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&rec.units[cnt%RING_SIZE], lit.content(), __ATOMIC_RELAXED);
+    cnt++;
+    // readers must not see the new count before the unit itself
+    __atomic_store_n(&rec.published, cnt, __ATOMIC_RELEASE);
+  }
+}
+
+/**
+ * Add to @b acc the units published by the other workers since the last call
+ */
+void SATPortfolioMode::collect(SATLiteralStack& acc)
+{
+  CALL("SATPortfolioMode::collect");
+
+  for(unsigned i=0; i<_workerCnt; i++) {
+    if(i==_index) {
+      continue;
+    }
+    WorkerRecord& rec = _records[i];
+    unsigned& cursor = _cursors[i];
+    unsigned published = __atomic_load_n(&rec.published, __ATOMIC_ACQUIRE);
+    if(published-cursor>RING_SIZE) {
+      // the older units were already overwritten
+      cursor = published-RING_SIZE;
+    }
+    for(; cursor!=published; cursor++) {
+      unsigned content = __atomic_load_n(&rec.units[cursor%RING_SIZE], __ATOMIC_RELAXED);
+      // the writer may have gone round the ring while we were reading;
+      // the fence keeps the re-read of the count after the read of the slot
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      unsigned now = __atomic_load_n(&rec.published, __ATOMIC_RELAXED);
+      // once the count reaches cursor+RING_SIZE the writer may be
+      // overwriting the slot
+      if(now-cursor>=RING_SIZE) {
+        continue;
+      }
+      acc.push(SATLiteral(content));
+    }
+  }
+}
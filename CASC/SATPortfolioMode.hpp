@@ -0,0 +1,105 @@
+/*
+ * File SATPortfolioMode.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file SATPortfolioMode.hpp
+ * Defines class SATPortfolioMode.
+ */
+
+#ifndef __SATPortfolioMode__
+#define __SATPortfolioMode__
+
+#include "Forwards.hpp"
+
+#include "Lib/DArray.hpp"
+#include "Lib/Portability.hpp"
+
+#include "SAT/SATClause.hpp"
+#include "SAT/SATLiteral.hpp"
+#include "SAT/SATSolver.hpp"
+
+namespace CASC
+{
+
+using namespace Lib;
+using namespace SAT;
+
+/**
+ * Solves a propositional problem by a portfolio of differently configured
+ * SAT solvers, each running in its own child process.
+ *
+ * As with the slices of PortfolioMode, the solvers run in forked processes
+ * rather than threads, because the SAT solvers allocate through the global
+ * Lib::Allocator and update the global statistics.
+ *
+ * The workers periodically publish the literals they have derived at
+ * the zero level and add those published by the others as unit clauses.
+ * Every worker has a ring buffer in memory shared by all the workers, which
+ * only the worker writes and the others read without locking. A reader
+ * that falls behind by more than the ring size skips the overwritten units.
+ */
+class SATPortfolioMode
+{
+public:
+  static SATSolver::Status solve(SATClauseList* clauses, unsigned varCnt);
+
+private:
+  enum {
+    /** Number of units each worker's ring buffer holds */
+    RING_SIZE = 4096
+  };
+
+  /** Part of the shared memory written by a single worker */
+  struct WorkerRecord
+  {
+    /** Number of units ever published by the worker */
+    unsigned published;
+    /** SATSolver::Status of the worker's result, valid once the worker exited with zero */
+    int status;
+    /** Contents of the published SATLiterals, the i-th unit is at index i%RING_SIZE */
+    unsigned units[RING_SIZE];
+  };
+
+  SATPortfolioMode(SATClauseList* clauses, unsigned varCnt, unsigned workerCnt);
+  ~SATPortfolioMode();
+
+  SATSolver::Status run();
+  void runWorker(unsigned index) NO_RETURN;
+  void solveInWorker(unsigned index) NO_RETURN;
+  SATSolver* createWorkerSolver(unsigned index, Shell::Options& opt, bool& canImport);
+
+  void publish(SATSolver& solver, DArray<bool>& published);
+  void collect(SATLiteralStack& acc);
+
+  static unsigned getNumWorkers();
+
+  SATClauseList* _clauses;
+  unsigned _varCnt;
+  unsigned _workerCnt;
+
+  /** Array of @b _workerCnt records in shared memory */
+  WorkerRecord* _records;
+
+  /** Index of the current process among the workers */
+  unsigned _index;
+  /** For each worker the number of its units the current process has read */
+  DArray<unsigned> _cursors;
+};
+
+}
+
+#endif // __SATPortfolioMode__
@@ -8,12 +8,15 @@
 #include "Lib/Sys/Multiprocessing.hpp"
 #include "Lib/Timer.hpp"
 #include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
 
 using namespace CASC;
 using namespace Lib;
 using namespace Lib::Sys;
 
 #define DECI(milli) (milli/100)
+// how long to sleep between looking at the progress of running slices
+#define STALL_POLL_MICROSECONDS 10000
 
 ScheduleExecutor::ScheduleExecutor(ProcessPriorityPolicy *policy, SliceExecutor *executor)
   : _policy(policy), _executor(executor)
@@ -63,10 +66,22 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
     float priority = _policy->staticPriority(code);
     queue.insert(priority, code);
   }
+  // number of queue items that were not started yet
+  unsigned waiting = schedule.size();
+
+  ProgressChannel progress(schedule.size());
+  unsigned nextSlot = 0;
+  _progress = &progress;
+  _progressSlots.reset();
+  _activity.reset();
 
   typedef List<pid_t> Pool;
   Pool *pool = Pool::empty();
 
+  unsigned stallTime = env.options->sliceStallTime();
+  // whether a running slice may still get extra time once nothing waits
+  bool extendable = true;
+
   bool success = false;
   while(Timer::syncClock(), DECI(env.timer->elapsedMilliseconds()) < terminationTime)
   {
@@ -79,27 +94,37 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
       pid_t process;
       if(!item.started())
       {
-        process = spawn(item.code(), terminationTime);
+        ASS_L(nextSlot,progress.size());
+        process = spawn(item.code(), terminationTime, &progress[nextSlot]);
+        _progressSlots.insert(process, nextSlot++);
+        waiting--;
       }
       else
       {
         process = item.process();
         Multiprocessing::instance()->kill(process, SIGCONT);
       }
+      ActivityMark mark;
+      mark.activeClauses = progress[_progressSlots.get(process)].activeClauses;
+      mark.time = DECI(env.timer->elapsedMilliseconds());
+      _activity.set(process, mark);
       Pool::push(process, pool);
       poolSize++;
     }
 
     bool stopped, exited;
     int code;
-    // sleep until process changes state
+    // with no slice waiting for a core and no slice to extend, sleep until
+    // process changes state, otherwise keep an eye on the running slices
+    bool watch = stallTime && (waiting || (queue.isEmpty() && extendable));
     pid_t process = Multiprocessing::instance()
-      ->poll_children(stopped, exited, code);
+      ->poll_children(stopped, exited, code, !watch);
 
     // child died, remove it from the pool and check if succeeded
     if(exited)
     {
       pool = Pool::remove(process, pool);
+      _activity.remove(process);
       if(!code)
       {
         success = true;
@@ -110,9 +135,22 @@ bool ScheduleExecutor::run(const Schedule &schedule, int terminationTime)
     else if(stopped)
     {
       pool = Pool::remove(process, pool);
-      float priority = _policy->dynamicPriority(process);
+      _activity.remove(process);
+      float priority = _policy->dynamicPriority(process, progress[_progressSlots.get(process)]);
       queue.insert(priority, Item(process));
     }
+    else if(watch)
+    {
+      if(waiting)
+      {
+        suspendStalled(pool);
+      }
+      else
+      {
+        extendable = extendProgressing(pool, terminationTime);
+      }
+      usleep(STALL_POLL_MICROSECONDS);
+    }
 
     // pool empty and queue exhausted - we failed
     if(!pool && queue.isEmpty())
@@ -129,9 +167,95 @@ exit:
     pid_t process = killIt.next();
     Multiprocessing::instance()->killNoCheck(process, SIGKILL);
   }
+  // suspended processes would otherwise stay around after we are done
+  while(!queue.isEmpty())
+  {
+    Item item = queue.pop();
+    if(item.started())
+    {
+      Multiprocessing::instance()->killNoCheck(item.process(), SIGKILL);
+    }
+  }
+  _progress = 0;
   return success;
 }
 
+/**
+ * Send SIGTSTP to the slices in @b pool that are saturating but have not
+ * activated a clause for longer than the slice_stall_time option.
+ *
+ * The slices stop themselves on SIGTSTP with their clock paused (see
+ * Timer::pauseWhileStopped), so they keep the rest of their time limit.
+ * The stopped slices are put back to the queue once @b poll_children()
+ * reports them as stopped.
+ */
+void ScheduleExecutor::suspendStalled(List<pid_t>* pool)
+{
+  CALL("ScheduleExecutor::suspendStalled");
+
+  int now = DECI(env.timer->elapsedMilliseconds());
+  int stallTime = env.options->sliceStallTime();
+
+  List<pid_t>::Iterator pit(pool);
+  while(pit.hasNext()) {
+    pid_t process = pit.next();
+    ActivityMark* mark = _activity.findPtr(process);
+    if(!mark) {
+      // already being stopped
+      continue;
+    }
+    const ProgressRecord& rec = (*_progress)[_progressSlots.get(process)];
+    if(rec.phase!=Shell::Statistics::SATURATION || rec.activeClauses!=mark->activeClauses) {
+      // only count time spent saturating without progress
+      mark->activeClauses = rec.activeClauses;
+      mark->time = now;
+      continue;
+    }
+    if(now - mark->time >= stallTime) {
+      _activity.remove(process);
+      Multiprocessing::instance()->killNoCheck(process, SIGTSTP);
+    }
+  }
+}
+
+/**
+ * Called when no slice waits for a core. Let the slices in @b pool that
+ * are saturating and have activated a clause within the last
+ * slice_stall_time deciseconds run until @b terminationTime instead of
+ * stopping at their own time limit, as their cores would stay idle anyway.
+ *
+ * Return true if some slice in @b pool has not been extended yet.
+ */
+bool ScheduleExecutor::extendProgressing(List<pid_t>* pool, int terminationTime)
+{
+  CALL("ScheduleExecutor::extendProgressing");
+
+  int now = DECI(env.timer->elapsedMilliseconds());
+  int stallTime = env.options->sliceStallTime();
+
+  bool res = false;
+  List<pid_t>::Iterator pit(pool);
+  while(pit.hasNext()) {
+    pid_t process = pit.next();
+    ProgressRecord& rec = (*_progress)[_progressSlots.get(process)];
+    ActivityMark* mark = _activity.findPtr(process);
+    if(rec.extraTime || !mark) {
+      continue;
+    }
+    if(rec.activeClauses!=mark->activeClauses) {
+      mark->activeClauses = rec.activeClauses;
+      mark->time = now;
+    }
+    if(rec.phase!=Shell::Statistics::SATURATION || now - mark->time >= stallTime) {
+      res = true;
+      continue;
+    }
+    // the slice's own limit counts from its start, so this is an upper bound
+    rec.extraTime = terminationTime - now;
+  }
+  return res;
+}
+
 unsigned ScheduleExecutor::getNumWorkers()
 {
   CALL("ScheduleExecutor::getNumWorkers");
@@ -146,7 +270,7 @@ unsigned ScheduleExecutor::getNumWorkers()
   return workers;
 }
 
-pid_t ScheduleExecutor::spawn(vstring code, int terminationTime)
+pid_t ScheduleExecutor::spawn(vstring code, int terminationTime, ProgressRecord* progress)
 {
   CALL("ScheduleExecutor::spawn");
 
@@ -161,6 +285,8 @@ pid_t ScheduleExecutor::spawn(vstring code, int terminationTime)
   // child
   else
   {
+    ProgressChannel::setPublishingSlot(progress);
+    Timer::pauseWhileStopped();
     _executor->runSlice(code, terminationTime);
     ASSERTION_VIOLATION; // should not return
   }
@@ -2,6 +2,11 @@
 #define __ScheduleExecutor__
 
 #include <unistd.h>
+
+#include "Lib/DHMap.hpp"
+#include "Lib/List.hpp"
+#include "Lib/Sys/ProgressChannel.hpp"
+
 #include "Schedules.hpp"
 
 namespace CASC
@@ -11,7 +16,11 @@ class ProcessPriorityPolicy
 {
 public:
   virtual float staticPriority(Lib::vstring sliceCode) = 0;
-  virtual float dynamicPriority(pid_t pid) = 0;
+  /**
+   * Priority of a slice that was suspended; @b progress is what the slice
+   * published last (all zeros if it published nothing)
+   */
+  virtual float dynamicPriority(pid_t pid, const Lib::Sys::ProgressRecord& progress) = 0;
 };
 
 class SliceExecutor
@@ -20,6 +29,16 @@ public:
   virtual void runSlice(Lib::vstring sliceCode, int terminationTime) NO_RETURN = 0;
 };
 
+/**
+ * Runs the slices of a schedule in a pool of at most getNumWorkers()
+ * child processes, one process per slice.
+ *
+ * Slices are deliberately not run on threads of the parent process:
+ * a slice adds symbols to the global Signature, terms to env.sharing and
+ * allocates through the global Lib::Allocator, none of which is safe to
+ * share between concurrently running provers. Forking gives every slice
+ * a private copy-on-write view of the parsed problem instead.
+ */
 class ScheduleExecutor
 {
 public:
@@ -27,12 +46,26 @@ public:
   bool run(const Schedule &schedule, int terminationTime);
 
 private:
-  pid_t spawn(Lib::vstring code, int terminationTime);
+  pid_t spawn(Lib::vstring code, int terminationTime, Lib::Sys::ProgressRecord* progress);
   unsigned getNumWorkers();
+  void suspendStalled(Lib::List<pid_t>* pool);
+  bool extendProgressing(Lib::List<pid_t>* pool, int terminationTime);
 
   ProcessPriorityPolicy *_policy;
   SliceExecutor *_executor;
   unsigned _numWorkers;
+
+  /** Progress published by the slices of the schedule being run, one record per slice */
+  Lib::Sys::ProgressChannel* _progress;
+  /** Index of the record in @b _progress of each started slice */
+  Lib::DHMap<pid_t,unsigned> _progressSlots;
+
+  /** Last seen activation count of a running slice and when it was seen to change */
+  struct ActivityMark {
+    unsigned activeClauses;
+    int time;
+  };
+  Lib::DHMap<pid_t,ActivityMark> _activity;
 };
 }
 
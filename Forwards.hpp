@@ -118,6 +118,7 @@ class Timer;
 
 namespace Sys
 {
+class MappedFile;
 class Semaphore;
 class SyncPipe;
 }
@@ -277,6 +278,7 @@ class LiteralIndexingStructure;
 class TermIndex;
 class TermIndexingStructure;
 class ClauseSubsumptionIndex;
+class FeatureVectorIndex;
 class FormulaIndex;
 
 class TermSharing;
@@ -29,7 +29,9 @@
 #include "Kernel/Clause.hpp"
 #include "Kernel/LiteralComparators.hpp"
 #include "Kernel/MLVariant.hpp"
+#include "Kernel/Renaming.hpp"
 #include "Kernel/Term.hpp"
+#include "Kernel/TermIterators.hpp"
 
 #include "LiteralMiniIndex.hpp"
 #include "LiteralSubstitutionTree.hpp"
@@ -519,6 +521,60 @@ unsigned HashingClauseVariantIndex::computeHashAndCountVariables(Literal* l, Var
   return hash;
 }
 
+/**
+ * Hash the variables of @b tl, numbered in the order of their first occurrence
+ * as recorded in @b normalizer.
+ */
+unsigned HashingClauseVariantIndex::hashNormalizedVariables(TermList* tl, Renaming& normalizer, unsigned hash_begin) {
+  CALL("HashingClauseVariantIndex::hashNormalizedVariables(TermList*, ...)");
+
+  unsigned hash = hash_begin;
+  VariableIterator vit(*tl);
+  while(vit.hasNext()) {
+    unsigned normVar = normalizer.getOrBind(vit.next().var());
+    hash = Hash::hash((const unsigned char*)&normVar,sizeof(normVar),hash);
+  }
+  return hash;
+}
+
+/**
+ * Hash the normalized variables of @b l, traversing the arguments in the same
+ * order as @b computeHashAndCountVariables does.
+ */
+unsigned HashingClauseVariantIndex::hashNormalizedVariables(Literal* l, Renaming& normalizer, unsigned hash_begin) {
+  CALL("HashingClauseVariantIndex::hashNormalizedVariables(Literal*, ...)");
+
+  if (l->ground()) {
+    return hash_begin;
+  }
+
+  unsigned hash = hash_begin;
+  if(l->isEquality()) {
+    TermList* ll = l->nthArgument(0);
+    TermList* lr = l->nthArgument(1);
+    if (VariableIgnoringComparator::compare(ll,lr) == LESS) {
+      swap(ll,lr);
+    }
+
+    hash = hashNormalizedVariables(ll,normalizer,hash);
+    hash = hashNormalizedVariables(lr,normalizer,hash);
+  } else {
+    for(TermList* arg=l->args(); arg->isNonEmpty(); arg=arg->next()) {
+      hash = hashNormalizedVariables(arg,normalizer,hash);
+    }
+  }
+  return hash;
+}
+
+/**
+ * Compute a hash of the clause with literals @b lits that is the same for all its variants.
+ *
+ * The literals are sorted by an order that ignores variables. If this order is strict
+ * on the non-ground literals and orients all their equalities, it determines the clause
+ * up to variable renaming, so the variables are normalized in the order of their first
+ * occurrence and hashed as well. Variant checks are then only needed on hash collisions.
+ * Otherwise only the histogram of variable occurrence counts is added to the hash.
+ */
 unsigned HashingClauseVariantIndex::computeHash(Literal* const * lits, unsigned length)
 {
   CALL("HashingClauseVariantIndex::computeHash");
@@ -542,7 +598,34 @@ unsigned HashingClauseVariantIndex::computeHash(Literal* const * lits, unsigned
     hash = computeHashAndCountVariables(lits[li],varCnts,hash);
   }
 
-  if (varCnts.size() > 0) {
+  if (varCnts.size() == 0) {
+    return hash;
+  }
+
+  bool canonical = true;
+  for(unsigned i=0; canonical && i<length; i++) {
+    Literal* l = lits[litOrder[i]];
+    if(l->ground()) {
+      continue;
+    }
+    if(i+1<length && VariableIgnoringComparator::compare(l,lits[litOrder[i+1]])==EQUAL) {
+      // the order of the two literals differs between variants
+      canonical = false;
+    }
+    else if(l->isEquality() &&
+        VariableIgnoringComparator::compare(l->nthArgument(0),l->nthArgument(1))==EQUAL) {
+      // the orientation of the equality differs between variants
+      canonical = false;
+    }
+  }
+
+  if (canonical) {
+    static Renaming normalizer;
+    normalizer.reset();
+    for(unsigned i=0; i<length; i++) {
+      hash = hashNormalizedVariables(lits[litOrder[i]],normalizer,hash);
+    }
+  } else {
     static Stack<unsigned char> varCntHistogram;
     varCntHistogram.reset();
     VarCounts::Iterator it(varCnts);
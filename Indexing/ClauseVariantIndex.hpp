@@ -123,6 +123,9 @@ private:
   unsigned computeHashAndCountVariables(TermList* tl, VarCounts& varCnts, unsigned hash_begin);
   unsigned computeHashAndCountVariables(Literal* l, VarCounts& varCnts, unsigned hash_begin);
 
+  unsigned hashNormalizedVariables(TermList* tl, Renaming& normalizer, unsigned hash_begin);
+  unsigned hashNormalizedVariables(Literal* l, Renaming& normalizer, unsigned hash_begin);
+
   unsigned computeHash(Literal* const * lits, unsigned length);
 
   DHMap<unsigned, ClauseList*> _entries;
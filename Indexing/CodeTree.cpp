@@ -40,6 +40,16 @@
 
 #define GROUND_TERM_CHECK 0
 
+/**
+ * If 1, Matcher::execute jumps between instruction handlers through
+ * a table of label addresses (a GCC extension) instead of a switch
+ */
+#ifdef __GNUC__
+#define THREADED_DISPATCH 1
+#else
+#define THREADED_DISPATCH 0
+#endif
+
 #undef RSTAT_COLLECTION
 #define RSTAT_COLLECTION 0
 
@@ -1466,6 +1476,85 @@ bool CodeTree::Matcher::execute()
     }
   }
 
+#if THREADED_DISPATCH
+  //handlers indexed by CodeOp::dispatchIndex()
+  static void* const handlers[16] = {
+      &&successOrFail, &&checkGroundTerm, &&litEnd, &&checkFun,
+      &&successOrFail, &&checkGroundTerm, &&litEnd, &&assignVar,
+      &&successOrFail, &&checkGroundTerm, &&litEnd, &&checkVar,
+      &&successOrFail, &&checkGroundTerm, &&litEnd, &&searchStruct
+  };
+
+#define DISPATCH() \
+  do { \
+    if(op->alternative()) { \
+      btStack.push(BTPoint(tp, op->alternative())); \
+    } \
+    goto *handlers[op->dispatchIndex()]; \
+  } while(0)
+  //the SEARCH_STRUCT operation does not appear in CodeBlocks and
+  //in each CodeBlock there is always either operation LIT_END or FAIL,
+  //so after other operations we may safely increase the operation pointer
+#define NEXT() \
+  do { \
+    ASS(!op->isSearchStruct()); \
+    op++; \
+    DISPATCH(); \
+  } while(0)
+#define BACKTRACK() \
+  do { \
+    if(!backtrack()) { \
+      return false; \
+    } \
+    DISPATCH(); \
+  } while(0)
+
+  DISPATCH();
+
+successOrFail:
+  //yield successes only in the first round (we don't want to yield the
+  //same thing for each query literal)
+  if(op->isFail() || curLInfo!=0) {
+    BACKTRACK();
+  }
+  return true;
+litEnd:
+  return true;
+checkGroundTerm:
+  if(!doCheckGroundTerm()) {
+    BACKTRACK();
+  }
+  NEXT();
+checkFun:
+  if(!doCheckFun()) {
+    BACKTRACK();
+  }
+  NEXT();
+assignVar:
+  doAssignVar();
+  //variable assignments cannot fail, so a run of them
+  //without alternatives is executed without dispatching
+  while(!op[1].alternative() && op[1].dispatchIndex()==op->dispatchIndex()) {
+    op++;
+    doAssignVar();
+  }
+  NEXT();
+checkVar:
+  if(!doCheckVar()) {
+    BACKTRACK();
+  }
+  NEXT();
+searchStruct:
+  if(!doSearchStruct()) {
+    BACKTRACK();
+  }
+  //a new value of @b op is assigned
+  DISPATCH();
+
+#undef DISPATCH
+#undef NEXT
+#undef BACKTRACK
+#else
 
   bool shouldBacktrack=false;
   for(;;) {
@@ -1530,6 +1619,7 @@ bool CodeTree::Matcher::execute()
       op++;
     }
   }
+#endif
 }
 
 /**
@@ -231,6 +231,13 @@ public:
       return static_cast<InstructionSuffix>(_info.suffix);
     }
 
+    /**
+     * Return a number in 0..15 determining the instruction, for
+     * instruction dispatch via a table. For instructions other than
+     * SUFFIX_INSTR, the upper two bits belong to the argument.
+     */
+    inline unsigned dispatchIndex() const { return _info.prefix | (_info.suffix<<2); }
+
     inline unsigned arg() const { return _info.arg; }
     inline CodeOp* alternative() const { return _alternative; }
     inline CodeOp*& alternative() { return _alternative; }
@@ -0,0 +1,224 @@
+/*
+ * File FeatureVectorIndex.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file FeatureVectorIndex.cpp
+ * Implements class FeatureVectorIndex.
+ */
+
+#include "Lib/TimeCounter.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Term.hpp"
+#include "Kernel/TermIterators.hpp"
+
+#include "FeatureVectorIndex.hpp"
+
+namespace Indexing
+{
+
+FeatureVectorIndex::FeatureVectorIndex()
+: _root(new Node())
+{
+}
+
+FeatureVectorIndex::~FeatureVectorIndex()
+{
+  CALL("FeatureVectorIndex::~FeatureVectorIndex");
+
+  destroy(_root);
+}
+
+void FeatureVectorIndex::destroy(Node* n)
+{
+  CALL("FeatureVectorIndex::destroy");
+
+  Stack<Node*> toDo;
+  toDo.push(n);
+  while(toDo.isNonEmpty()) {
+    Node* curr=toDo.pop();
+    Stack<Child>::Iterator cit(curr->children);
+    while(cit.hasNext()) {
+      toDo.push(cit.next().node);
+    }
+    delete curr;
+  }
+}
+
+/**
+ * Assign features of @b cl into @b features
+ *
+ * The literal counts come first as they split the clauses the least,
+ * so that the upper levels of the trie are shared the most.
+ */
+void FeatureVectorIndex::computeFeatures(Clause* cl, DArray<unsigned>& features)
+{
+  CALL("FeatureVectorIndex::computeFeatures");
+
+  features.init(FEATURE_CNT, 0);
+
+  unsigned clen=cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    Literal* lit=(*cl)[i];
+    unsigned pol=lit->isPositive() ? 0 : 1;
+    features[pol]++;
+    features[2+pol*SYMBOL_BUCKETS+lit->functor()%SYMBOL_BUCKETS]++;
+
+    unsigned funFeatures=2+(2+pol)*SYMBOL_BUCKETS;
+    NonVariableIterator nvi(lit);
+    while(nvi.hasNext()) {
+      features[funFeatures+nvi.next().term()->functor()%SYMBOL_BUCKETS]++;
+    }
+  }
+}
+
+void FeatureVectorIndex::handleClause(Clause* cl, bool adding)
+{
+  CALL("FeatureVectorIndex::handleClause");
+
+  TimeCounter tc(TC_BACKWARD_SUBSUMPTION_INDEX_MAINTENANCE);
+
+  if(adding) {
+    insert(cl);
+  }
+  else {
+    remove(cl);
+  }
+}
+
+void FeatureVectorIndex::insert(Clause* cl)
+{
+  CALL("FeatureVectorIndex::insert");
+
+  static DArray<unsigned> features;
+  computeFeatures(cl, features);
+
+  Node* n=_root;
+  for(unsigned d=0;d<FEATURE_CNT;d++) {
+    unsigned val=features[d];
+    Stack<Child>& children=n->children;
+    size_t i=0;
+    while(i<children.size() && children[i].val<val) {
+      i++;
+    }
+    if(i==children.size() || children[i].val!=val) {
+      //insert a new child keeping the children sorted
+      children.push(Child(val, new Node()));
+      for(size_t j=children.size()-1;j>i;j--) {
+	std::swap(children[j], children[j-1]);
+      }
+    }
+    n=children[i].node;
+  }
+  n->clauses.push(cl);
+}
+
+void FeatureVectorIndex::remove(Clause* cl)
+{
+  CALL("FeatureVectorIndex::remove");
+
+  static DArray<unsigned> features;
+  computeFeatures(cl, features);
+
+  //nodes on the path to the leaf together with the index of the child taken
+  static Stack<pair<Node*,size_t> > path;
+  path.reset();
+
+  Node* n=_root;
+  for(unsigned d=0;d<FEATURE_CNT;d++) {
+    unsigned val=features[d];
+    Stack<Child>& children=n->children;
+    size_t i=0;
+    while(i<children.size() && children[i].val!=val) {
+      i++;
+    }
+    ASS_L(i,children.size());
+    path.push(make_pair(n,i));
+    n=children[i].node;
+  }
+  ALWAYS(n->clauses.remove(cl));
+
+  //remove the nodes that became empty
+  while(n->clauses.isEmpty() && n->children.isEmpty() && path.isNonEmpty()) {
+    delete n;
+    pair<Node*,size_t> parent=path.pop();
+    Stack<Child>& children=parent.first->children;
+    for(size_t j=parent.second+1;j<children.size();j++) {
+      children[j-1]=children[j];
+    }
+    children.pop();
+    n=parent.first;
+  }
+}
+
+/**
+ * Add to @b acc the clauses whose features are all at most (if
+ * @b subsuming is true) or at least (otherwise) those of @b cl
+ */
+void FeatureVectorIndex::getCandidates(Clause* cl, bool subsuming, ClauseStack& acc)
+{
+  CALL("FeatureVectorIndex::getCandidates");
+
+  static DArray<unsigned> features;
+  computeFeatures(cl, features);
+
+  static Stack<pair<Node*,unsigned> > toDo;
+  toDo.reset();
+  toDo.push(make_pair(_root,0u));
+  while(toDo.isNonEmpty()) {
+    Node* n=toDo.top().first;
+    unsigned d=toDo.pop().second;
+    if(d==FEATURE_CNT) {
+      acc.loadFromIterator(ClauseStack::BottomFirstIterator(n->clauses));
+      continue;
+    }
+    unsigned val=features[d];
+    Stack<Child>& children=n->children;
+    if(subsuming) {
+      for(size_t i=0;i<children.size() && children[i].val<=val;i++) {
+	toDo.push(make_pair(children[i].node,d+1));
+      }
+    }
+    else {
+      for(size_t i=children.size();i>0 && children[i-1].val>=val;i--) {
+	toDo.push(make_pair(children[i-1].node,d+1));
+      }
+    }
+  }
+}
+
+/**
+ * Add to @b acc clauses that may subsume @b cl
+ */
+void FeatureVectorIndex::getSubsumingCandidates(Clause* cl, ClauseStack& acc)
+{
+  CALL("FeatureVectorIndex::getSubsumingCandidates");
+
+  getCandidates(cl, true, acc);
+}
+
+/**
+ * Add to @b acc clauses that may be subsumed by @b cl
+ */
+void FeatureVectorIndex::getSubsumedCandidates(Clause* cl, ClauseStack& acc)
+{
+  CALL("FeatureVectorIndex::getSubsumedCandidates");
+
+  getCandidates(cl, false, acc);
+}
+
+}
@@ -0,0 +1,115 @@
+/*
+ * File FeatureVectorIndex.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file FeatureVectorIndex.hpp
+ * Defines class FeatureVectorIndex.
+ */
+
+#ifndef __FeatureVectorIndex__
+#define __FeatureVectorIndex__
+
+#include "Forwards.hpp"
+
+#include "Lib/DArray.hpp"
+#include "Lib/Stack.hpp"
+
+#include "Index.hpp"
+
+namespace Indexing {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Index of clauses by vectors of integer features, as in the feature
+ * vector indexing of the E prover.
+ *
+ * Every feature of a clause is a number that cannot decrease when the
+ * clause is instantiated or extended by further literals. So if a clause C
+ * subsumes D (as a multiset), every feature of C is at most the same
+ * feature of D. The index is a trie over the feature values and retrieves
+ * candidate subsuming clauses (features all at most those of the query)
+ * and candidate subsumed clauses (features all at least those of the
+ * query). The candidates still have to be checked by a matcher.
+ */
+class FeatureVectorIndex
+: public Index
+{
+public:
+  CLASS_NAME(FeatureVectorIndex);
+  USE_ALLOCATOR(FeatureVectorIndex);
+
+  FeatureVectorIndex();
+  ~FeatureVectorIndex();
+
+  void getSubsumingCandidates(Clause* cl, ClauseStack& acc);
+  void getSubsumedCandidates(Clause* cl, ClauseStack& acc);
+
+protected:
+  //overrides Index::handleClause
+  void handleClause(Clause* cl, bool adding);
+
+private:
+  enum {
+    /** Number of buckets symbols are distributed into by their numbers */
+    SYMBOL_BUCKETS = 4,
+    /**
+     * Number of features: counts of positive and negative literals,
+     * and for each polarity and bucket the number of literals with
+     * a predicate from the bucket and the number of occurrences of
+     * function symbols from the bucket.
+     */
+    FEATURE_CNT = 2 + 4*SYMBOL_BUCKETS
+  };
+
+  struct Node;
+  /** Child of a trie node with the feature value leading to it */
+  struct Child
+  {
+    Child() {}
+    Child(unsigned val, Node* node) : val(val), node(node) {}
+
+    unsigned val;
+    Node* node;
+  };
+  /**
+   * Trie node. Inner nodes have children sorted by the feature value,
+   * nodes at depth FEATURE_CNT store the clauses with the feature vector.
+   */
+  struct Node
+  {
+    CLASS_NAME(FeatureVectorIndex::Node);
+    USE_ALLOCATOR(Node);
+
+    Stack<Child> children;
+    ClauseStack clauses;
+  };
+
+  static void computeFeatures(Clause* cl, DArray<unsigned>& features);
+  static void destroy(Node* n);
+
+  void insert(Clause* cl);
+  void remove(Clause* cl);
+  void getCandidates(Clause* cl, bool subsuming, ClauseStack& acc);
+
+  Node* _root;
+};
+
+}
+
+#endif // __FeatureVectorIndex__
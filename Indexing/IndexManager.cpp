@@ -30,6 +30,7 @@
 #include "AcyclicityIndex.hpp"
 #include "ArithmeticIndex.hpp"
 #include "CodeTreeInterfaces.hpp"
+#include "FeatureVectorIndex.hpp"
 #include "GroundingIndex.hpp"
 #include "LiteralIndex.hpp"
 #include "LiteralSubstitutionTree.hpp"
@@ -142,6 +143,31 @@ void IndexManager::provideIndex(IndexType t, Index* index)
   _store.set(t,e);
 }
 
+/**
+ * True if the substitution tree of index @b t should use
+ * SubstitutionTree::SArrIntermediateNode for its large nodes.
+ *
+ * These are the indices queried for unifiers and generalizations
+ * of every clause that is activated or simplified.
+ */
+bool IndexManager::useCompactNodes(IndexType t)
+{
+  CALL("IndexManager::useCompactNodes");
+
+  if(!env.options->compactSubstitutionTrees()) {
+    return false;
+  }
+  switch(t) {
+  case GENERATING_SUBST_TREE:
+  case SUPERPOSITION_SUBTERM_SUBST_TREE:
+  case SUPERPOSITION_LHS_SUBST_TREE:
+  case DEMODULATION_SUBTERM_SUBST_TREE:
+    return true;
+  default:
+    return false;
+  }
+}
+
 Index* IndexManager::create(IndexType t)
 {
   CALL("IndexManager::create");
@@ -152,9 +178,10 @@ Index* IndexManager::create(IndexType t)
 
   bool isGenerating;
   static bool useConstraints = env.options->unificationWithAbstraction()!=Options::UnificationWithAbstraction::OFF;
+  bool compact = useCompactNodes(t);
   switch(t) {
   case GENERATING_SUBST_TREE:
-    is=new LiteralSubstitutionTree(useConstraints);
+    is=new LiteralSubstitutionTree(useConstraints,compact);
 #if VDEBUG
     //is->markTagged();
 #endif
@@ -185,7 +212,7 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case SUPERPOSITION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    tis=new TermSubstitutionTree(useConstraints,compact);
 #if VDEBUG
     //tis->markTagged();
 #endif
@@ -193,7 +220,7 @@ Index* IndexManager::create(IndexType t)
     isGenerating = true;
     break;
   case SUPERPOSITION_LHS_SUBST_TREE:
-    tis=new TermSubstitutionTree(useConstraints);
+    tis=new TermSubstitutionTree(useConstraints,compact);
     res=new SuperpositionLHSIndex(tis, _alg->getOrdering(), _alg->getOptions());
     isGenerating = true;
     break;
@@ -205,7 +232,7 @@ Index* IndexManager::create(IndexType t)
     break;
 
   case DEMODULATION_SUBTERM_SUBST_TREE:
-    tis=new TermSubstitutionTree();
+    tis=new TermSubstitutionTree(false,compact);
     res=new DemodulationSubtermIndex(tis);
     isGenerating = false;
     break;
@@ -228,6 +255,11 @@ Index* IndexManager::create(IndexType t)
     isGenerating = false;
     break;
 
+  case FEATURE_VECTOR_SUBSUMPTION_INDEX:
+    res=new FeatureVectorIndex();
+    isGenerating = false;
+    break;
+
   case REWRITE_RULE_SUBST_TREE:
     is=new LiteralSubstitutionTree();
     res=new RewriteRuleIndex(is, _alg->getOrdering());
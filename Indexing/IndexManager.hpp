@@ -53,6 +53,7 @@ enum IndexType {
 
   FW_SUBSUMPTION_SUBST_TREE,
   BW_SUBSUMPTION_SUBST_TREE,
+  FEATURE_VECTOR_SUBSUMPTION_INDEX,
 
   REWRITE_RULE_SUBST_TREE,
 
@@ -94,6 +95,7 @@ private:
   LiteralIndexingStructure* _genLitIndex;
 
   Index* create(IndexType t);
+  static bool useCompactNodes(IndexType t);
 };
 
 };
@@ -87,16 +87,36 @@ void LiteralIndex::handleLiteral(Literal* lit, Clause* cl, bool add)
   }
 }
 
+/**
+ * Insert or remove the first @b cnt literals of @b cl as one batch
+ */
+void LiteralIndex::handleLiterals(Clause* cl, unsigned cnt, bool add)
+{
+  CALL("LiteralIndex::handleLiterals");
+
+  if(cnt==1) {
+    handleLiteral((*cl)[0], cl, add);
+    return;
+  }
+  static LiteralIndexingStructure::EntryStack entries;
+  entries.reset();
+  for(unsigned i=0; i<cnt; i++) {
+    entries.push(LiteralIndexingStructure::Entry((*cl)[i], cl));
+  }
+  if(add) {
+    _is->insert(entries);
+  } else {
+    _is->remove(entries);
+  }
+}
+
 void GeneratingLiteralIndex::handleClause(Clause* c, bool adding)
 {
   CALL("GeneratingLiteralIndex::handleClause");
 
   TimeCounter tc(TC_BINARY_RESOLUTION_INDEX_MAINTENANCE);
 
-  int selCnt=c->numSelected();
-  for(int i=0; i<selCnt; i++) {
-    handleLiteral((*c)[i], c, adding);
-  }
+  handleLiterals(c, c->numSelected(), adding);
 }
 
 void SimplifyingLiteralIndex::handleClause(Clause* c, bool adding)
@@ -105,10 +125,7 @@ void SimplifyingLiteralIndex::handleClause(Clause* c, bool adding)
 
   TimeCounter tc(TC_BACKWARD_SUBSUMPTION_INDEX_MAINTENANCE);
 
-  unsigned clen=c->length();
-  for(unsigned i=0; i<clen; i++) {
-    handleLiteral((*c)[i], c, adding);
-  }
+  handleLiterals(c, c->length(), adding);
 }
 
 void FwSubsSimplifyingLiteralIndex::handleClause(Clause* c, bool adding)
@@ -155,9 +172,7 @@ void NonUnitClauseLiteralIndex::handleClause(Clause* c, bool adding)
   }
   TimeCounter tc(TC_NON_UNIT_LITERAL_INDEX_MAINTENANCE);
   unsigned activeLen = _selectedOnly ? c->numSelected() : clen;
-  for(unsigned i=0; i<activeLen; i++) {
-    handleLiteral((*c)[i], c, adding);
-  }
+  handleLiterals(c, activeLen, adding);
 }
 
 RewriteRuleIndex::RewriteRuleIndex(LiteralIndexingStructure* is, Ordering& ordering)
@@ -61,6 +61,7 @@ protected:
   LiteralIndex(LiteralIndexingStructure* is) : _is(is) {}
 
   void handleLiteral(Literal* lit, Clause* cl, bool add);
+  void handleLiterals(Clause* cl, unsigned cnt, bool add);
 
   LiteralIndexingStructure* _is;
 };
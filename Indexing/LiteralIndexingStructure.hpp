@@ -26,6 +26,7 @@
 #define __LiteralIndexingStructure__
 
 #include "Forwards.hpp"
+#include "Lib/Stack.hpp"
 #include "Index.hpp"
 
 namespace Indexing {
@@ -37,6 +38,36 @@ public:
   virtual void insert(Literal* lit, Clause* cls) = 0;
   virtual void remove(Literal* lit, Clause* cls) = 0;
 
+  /** A literal of a clause, for insertion or removal in a batch */
+  struct Entry {
+    Entry() {}
+    Entry(Literal* lit, Clause* cls) : lit(lit), cls(cls) {}
+    Literal* lit;
+    Clause* cls;
+  };
+  typedef Stack<Entry> EntryStack;
+
+  /**
+   * Insert all literals in @b entries. Structures that can share work
+   * between the insertions override this. The stack may be reordered.
+   */
+  virtual void insert(EntryStack& entries)
+  {
+    for(unsigned i=0;i<entries.size();i++) {
+      insert(entries[i].lit, entries[i].cls);
+    }
+  }
+  /**
+   * Remove all literals in @b entries. Structures that can share work
+   * between the removals override this. The stack may be reordered.
+   */
+  virtual void remove(EntryStack& entries)
+  {
+    for(unsigned i=0;i<entries.size();i++) {
+      remove(entries[i].lit, entries[i].cls);
+    }
+  }
+
   virtual SLQueryResultIterator getAll() { NOT_IMPLEMENTED; }
   virtual SLQueryResultIterator getUnifications(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
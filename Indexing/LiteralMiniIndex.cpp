@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include "Lib/Allocator.hpp"
+#include "Lib/Stack.hpp"
 
 #include "LiteralMiniIndex.hpp"
 
@@ -36,6 +37,57 @@ using namespace Kernel;
 int LiteralMiniIndex::badPred=0;*/
 
 
+const LiteralMiniIndex::Features LiteralMiniIndex::FEATURE_HIGH_BITS;
+
+/**
+ * Return the feature vector of @b lit
+ */
+LiteralMiniIndex::Features LiteralMiniIndex::getFeatures(Literal* lit)
+{
+  CALL("LiteralMiniIndex::getFeatures");
+
+  unsigned counts[FEATURE_SYMBOL_BUCKETS+1];
+  for(unsigned i=0;i<=FEATURE_SYMBOL_BUCKETS;i++) {
+    counts[i]=0;
+  }
+  unsigned& depth=counts[FEATURE_SYMBOL_BUCKETS];
+
+  static Stack<TermList*> toDo(8);
+  static Stack<unsigned> depths(8);
+  ASS(toDo.isEmpty() && depths.isEmpty());
+  if(lit->arity()) {
+    toDo.push(lit->args());
+    depths.push(1);
+  }
+  while(toDo.isNonEmpty()) {
+    TermList* ts=toDo.pop();
+    unsigned d=depths.pop();
+    if(!ts->next()->isEmpty()) {
+      toDo.push(ts->next());
+      depths.push(d);
+    }
+    if(d>depth) {
+      depth=d;
+    }
+    if(!ts->isTerm()) {
+      continue;
+    }
+    Term* t=ts->term();
+    counts[t->functor()%FEATURE_SYMBOL_BUCKETS]++;
+    if(t->arity()) {
+      toDo.push(t->args());
+      depths.push(d+1);
+    }
+  }
+
+  Features res=0;
+  for(unsigned i=0;i<=FEATURE_SYMBOL_BUCKETS;i++) {
+    Features val=min(counts[i],static_cast<unsigned>(FEATURE_MAX));
+    res|=val<<(8*i);
+  }
+  return res;
+}
+
 bool LiteralMiniIndex::literalHeaderComparator(const Entry& e1, const Entry& e2)
 {
   return e1._header<e2._header || ( e1._header==e2._header && e1._weight<e2._weight );
@@ -48,13 +48,48 @@ public:
 private:
   void init(Literal* const * lits);
 
+  /**
+   * Feature vector of a literal packed into bytes of a 64-bit word.
+   *
+   * Byte i<FEATURE_SYMBOL_BUCKETS holds the number of occurrences of function
+   * symbols f with f%FEATURE_SYMBOL_BUCKETS==i, the last byte holds the depth
+   * of the literal. All values are capped at FEATURE_MAX. None of the features
+   * can decrease by applying a substitution, so an instance of a literal
+   * must have every feature at least as big as the literal.
+   */
+  typedef unsigned long long Features;
+
+  enum {
+    FEATURE_SYMBOL_BUCKETS = 7,
+    FEATURE_MAX = 0x7F
+  };
+  /** Highest bit of every byte of Features */
+  static const Features FEATURE_HIGH_BITS=0x8080808080808080ULL;
+
+  static Features getFeatures(Literal* lit);
+
+  /**
+   * Return false if a literal with features @b inst cannot be an instance
+   * of a literal with features @b base
+   *
+   * All bytes are compared at once: as no byte exceeds FEATURE_MAX,
+   * setting the high bit of each byte of @b inst keeps the byte-wise
+   * subtraction from borrowing, and the high bit of a byte of the result
+   * remains set iff the byte of @b inst is not smaller than that of @b base.
+   */
+  static bool couldBeInstance(Features base, Features inst)
+  {
+    return (((inst | FEATURE_HIGH_BITS) - base) & FEATURE_HIGH_BITS) == FEATURE_HIGH_BITS;
+  }
+
   struct Entry
   {
     Entry() {}
     void initTerminal() { _header=0xFFFFFFFF; _lit=0; }
-    void init(Literal* lit) { _header=lit->header(); _weight=lit->weight(); _lit=lit; }
+    void init(Literal* lit) { _header=lit->header(); _weight=lit->weight(); _features=getFeatures(lit); _lit=lit; }
     unsigned _header;
     unsigned _weight;
+    Features _features;
     Literal* _lit;
   };
 
@@ -116,7 +151,7 @@ public:
   : BaseIterator
   {
     InstanceIterator(LiteralMiniIndex& index, Literal* base, bool complementary)
-    : BaseIterator(index, base, complementary)
+    : BaseIterator(index, base, complementary), _haveFeatures(false)
     {}
 
     bool hasNext()
@@ -124,8 +159,14 @@ public:
       CALL("LiteralMiniIndex::InstanceIterator::hasNext");
 
       if(_ready) { return true; }
+      if(!_haveFeatures && _curr->_header==_hdr) {
+	//the features are only needed if there is a literal with the same header
+	_features=getFeatures(_query);
+	_haveFeatures=true;
+      }
       while(_curr->_header==_hdr) {
-	bool prediction=_curr->_lit->couldArgsBeInstanceOf(_query);
+	bool prediction=couldBeInstance(_features, _curr->_features) &&
+	    _curr->_lit->couldArgsBeInstanceOf(_query);
 #if VDEBUG
 	if(MatchingUtils::match(_query, _curr->_lit, _compl)) {
 	  ASS(prediction);
@@ -144,6 +185,9 @@ public:
     {
       return BaseIterator::next();
     }
+  private:
+    bool _haveFeatures;
+    Features _features;
   };
 
   struct VariantIterator
@@ -35,8 +35,8 @@
 namespace Indexing
 {
 
-LiteralSubstitutionTree::LiteralSubstitutionTree(bool useC)
-: SubstitutionTree(2*env.signature->predicates(),useC)
+LiteralSubstitutionTree::LiteralSubstitutionTree(bool useC, bool compact)
+: SubstitutionTree(2*env.signature->predicates(),useC,compact)
 {
 }
 
@@ -68,6 +68,25 @@ void LiteralSubstitutionTree::handleLiteral(Literal* lit, Clause* cls, bool inse
   }
 }
 
+/**
+ * According to value of @b insert, insert or remove all literals
+ * in @b entries, traversing the tree once for each group of literals
+ * that are variants of each other.
+ */
+void LiteralSubstitutionTree::handleLiterals(EntryStack& entries, bool insert)
+{
+  CALL("LiteralSubstitutionTree::handleLiterals");
+
+  static Stack<BatchEntry> batch;
+  batch.reset();
+  for(unsigned i=0;i<entries.size();i++) {
+    const Entry& e=entries[i];
+    Literal* normLit=Renaming::normalize(e.lit);
+    batch.push(BatchEntry(getRootNodeIndex(normLit), normLit, LeafData(e.cls, e.lit)));
+  }
+  handleBatch(batch, insert);
+}
+
 SLQueryResultIterator LiteralSubstitutionTree::getUnifications(Literal* lit,
 	  bool complementary, bool retrieveSubstitutions)
 {
@@ -37,12 +37,16 @@ public:
   CLASS_NAME(LiteralSubstitutionTree);
   USE_ALLOCATOR(LiteralSubstitutionTree);
 
-  LiteralSubstitutionTree(bool useC=false);
+  LiteralSubstitutionTree(bool useC=false, bool compact=false);
 
   void insert(Literal* lit, Clause* cls);
   void remove(Literal* lit, Clause* cls);
   void handleLiteral(Literal* lit, Clause* cls, bool insert);
 
+  void insert(EntryStack& entries) { handleLiterals(entries, true); }
+  void remove(EntryStack& entries) { handleLiterals(entries, false); }
+  void handleLiterals(EntryStack& entries, bool insert);
+
   SLQueryResultIterator getAll();
 
   SLQueryResultIterator getUnifications(Literal* lit,
@@ -36,6 +36,8 @@
 #include "Lib/Metaiterators.hpp"
 #include "Lib/Environment.hpp"
 #include "Lib/Recycler.hpp"
+#include "Lib/DArray.hpp"
+#include "Lib/DHMap.hpp"
 #include "Lib/DHMultiset.hpp"
 
 #include "TermSharing.hpp"
@@ -60,8 +62,8 @@ using namespace Indexing;
  * Initialise the substitution tree.
  * @since 16/08/2008 flight Sydney-San Francisco
  */
-SubstitutionTree::SubstitutionTree(int nodes,bool useC)
-  : tag(false), _nextVar(0), _nodes(nodes), _useC(useC)
+SubstitutionTree::SubstitutionTree(int nodes,bool useC,bool compact)
+  : tag(false), _nextVar(0), _nodes(nodes), _useC(useC), _compact(compact)
 {
   CALL("SubstitutionTree::SubstitutionTree");
 
@@ -143,19 +145,81 @@ struct BindingComparator
 
 
 /**
- * Insert an entry to the substitution tree.
+ * Insert (or remove, if @b insert is false) all entries of @b batch.
+ *
+ * Entries with the same normalized term end up in the same leaf, so the
+ * tree is traversed only once for each such group. The groups are handled
+ * in the order of their first entries in @b batch and within a group the
+ * entries are handled in the order in which they are in @b batch, so the
+ * result does not depend on the addresses of the terms.
+ */
+void SubstitutionTree::handleBatch(Stack<BatchEntry>& batch, bool insert)
+{
+  CALL("SubstitutionTree::handleBatch");
+
+  //number the groups in the order of their first entries
+  static DHMap<pair<unsigned,Term*>,unsigned> groupNums;
+  //index in batch of the first entry of each group
+  static Stack<unsigned> groupFirsts;
+  groupNums.reset();
+  groupFirsts.reset();
+  for(unsigned i=0;i<batch.size();i++) {
+    unsigned* group;
+    if(groupNums.getValuePtr(make_pair(batch[i].root, batch[i].normTerm), group)) {
+      *group=groupFirsts.size();
+      groupFirsts.push(i);
+    }
+    batch[i].group=*group;
+  }
+  unsigned groupCnt=groupFirsts.size();
+
+  //place the leaf data of each group next to each other, keeping their order
+  static DArray<unsigned> groupStarts;
+  static DArray<unsigned> groupCursors;
+  groupStarts.init(groupCnt+1, 0);
+  for(unsigned i=0;i<batch.size();i++) {
+    groupStarts[batch[i].group+1]++;
+  }
+  for(unsigned g=0;g<groupCnt;g++) {
+    groupStarts[g+1]+=groupStarts[g];
+  }
+  groupCursors.initFromArray(groupCnt, groupStarts);
+  static DArray<LeafData> lds;
+  lds.ensure(batch.size());
+  for(unsigned i=0;i<batch.size();i++) {
+    lds[groupCursors[batch[i].group]++]=batch[i].ld;
+  }
+
+  for(unsigned g=0;g<groupCnt;g++) {
+    const BatchEntry& first=batch[groupFirsts[g]];
+    BindingMap svBindings;
+    getBindings(first.normTerm, svBindings);
+    unsigned start=groupStarts[g];
+    unsigned cnt=groupStarts[g+1]-start;
+    if(insert) {
+      SubstitutionTree::insert(&_nodes[first.root], svBindings, lds.array()+start, cnt);
+    } else {
+      SubstitutionTree::remove(&_nodes[first.root], svBindings, lds.array()+start, cnt);
+    }
+  }
+}
+
+/**
+ * Insert entries to the substitution tree.
  *
  * @b pnode is pointer to root of tree corresponding to
  * top symbol of the term/literal being inserted, and
- * @b bh contains its arguments.
+ * @b bh contains its arguments. All @b cnt entries in
+ * @b lds are inserted into the leaf of this term/literal.
  */
-void SubstitutionTree::insert(Node** pnode,BindingMap& svBindings,LeafData ld)
+void SubstitutionTree::insert(Node** pnode,BindingMap& svBindings,const LeafData* lds,unsigned cnt)
 {
-  CALL("SubstitutionTree::insert/3");
+  CALL("SubstitutionTree::insert/4");
   ASS_EQ(_iteratorCnt,0);
+  ASS_G(cnt,0);
 
 #if VDEBUG
-  if(tag){cout << "Insert " << ld.toString() << endl;}
+  if(tag){cout << "Insert " << const_cast<LeafData*>(lds)->toString() << endl;}
 #endif
 
   if(*pnode == 0) {
@@ -168,7 +232,9 @@ void SubstitutionTree::insert(Node** pnode,BindingMap& svBindings,LeafData ld)
   if(svBindings.isEmpty()) {
     ASS((*pnode)->isLeaf());
     ensureLeafEfficiency(reinterpret_cast<Leaf**>(pnode));
-    static_cast<Leaf*>(*pnode)->insert(ld);
+    for(unsigned i=0;i<cnt;i++) {
+      static_cast<Leaf*>(*pnode)->insert(lds[i]);
+    }
     return;
   }
 
@@ -273,9 +339,11 @@ start:
     }
     Leaf* lnode=createLeaf(term);
     *pnode=lnode;
-    lnode->insert(ld);
+    for(unsigned i=0;i<cnt;i++) {
+      lnode->insert(lds[i]);
+    }
 
-    ensureIntermediateNodeEfficiency(reinterpret_cast<IntermediateNode**>(pparent));
+    ensureIntermediateNodeEfficiency(reinterpret_cast<IntermediateNode**>(pparent),_compact);
     return;
   }
 
@@ -348,7 +416,9 @@ start:
     ASS((*pnode)->isLeaf());
     ensureLeafEfficiency(reinterpret_cast<Leaf**>(pnode));
     Leaf* leaf = static_cast<Leaf*>(*pnode);
-    leaf->insert(ld);
+    for(unsigned i=0;i<cnt;i++) {
+      leaf->insert(lds[i]);
+    }
     return;
   }
 
@@ -356,16 +426,17 @@ start:
 } // // SubstitutionTree::insert
 
 /*
- * Remove an entry from the substitution tree.
+ * Remove entries from the substitution tree.
  *
  * @b pnode is pointer to root of tree corresponding to
  * top symbol of the term/literal being removed, and
- * @b bh contains its arguments.
+ * @b bh contains its arguments. All @b cnt entries in
+ * @b lds are removed from the leaf of this term/literal.
  *
  * If the removal results in a chain of nodes containing
  * no terms/literals, all those nodes are removed as well.
  */
-void SubstitutionTree::remove(Node** pnode,BindingMap& svBindings,LeafData ld)
+void SubstitutionTree::remove(Node** pnode,BindingMap& svBindings,const LeafData* lds,unsigned cnt)
 {
   CALL("SubstitutionTree::remove-2");
   ASS_EQ(_iteratorCnt,0);
@@ -436,7 +507,9 @@ void SubstitutionTree::remove(Node** pnode,BindingMap& svBindings,LeafData ld)
 
 
   Leaf* lnode = static_cast<Leaf*>(*pnode);
-  lnode->remove(ld);
+  for(unsigned i=0;i<cnt;i++) {
+    lnode->remove(lds[i]);
+  }
   ensureLeafEfficiency(reinterpret_cast<Leaf**>(pnode));
 
   while( (*pnode)->isEmpty() ) {
@@ -451,7 +524,7 @@ void SubstitutionTree::remove(Node** pnode,BindingMap& svBindings,LeafData ld)
       parent->remove(term);
       delete node;
       pnode=history.pop();
-      ensureIntermediateNodeEfficiency(reinterpret_cast<IntermediateNode**>(pnode));
+      ensureIntermediateNodeEfficiency(reinterpret_cast<IntermediateNode**>(pnode),_compact);
     }
   }
 } // SubstitutionTree::remove
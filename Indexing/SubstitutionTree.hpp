@@ -84,7 +84,7 @@ public:
   CLASS_NAME(SubstitutionTree);
   USE_ALLOCATOR(SubstitutionTree);
 
-  SubstitutionTree(int nodes,bool useC=false);
+  SubstitutionTree(int nodes,bool useC=false,bool compact=false);
   ~SubstitutionTree();
 
   // Tags are used as a debug tool to turn debugging on for a particular instance
@@ -155,7 +155,8 @@ public:
   {
     UNSORTED_LIST=1,
     SKIP_LIST=2,
-    SET=3
+    SET=3,
+    SORTED_ARRAY=4
   };
 
   class Node {
@@ -410,12 +411,13 @@ public:
   class SListIntermediateNode;
   class SListLeaf;
   class SetLeaf;
+  class SArrIntermediateNode;
   static Leaf* createLeaf();
   static Leaf* createLeaf(TermList ts);
   static void ensureLeafEfficiency(Leaf** l);
   static IntermediateNode* createIntermediateNode(unsigned childVar,bool constraints);
   static IntermediateNode* createIntermediateNode(TermList ts, unsigned childVar,bool constraints);
-  static void ensureIntermediateNodeEfficiency(IntermediateNode** inode);
+  static void ensureIntermediateNodeEfficiency(IntermediateNode** inode,bool compact);
 
   struct IsPtrToVarNodeFn
   {
@@ -606,6 +608,106 @@ public:
    }
   };
 
+  /**
+   * Intermediate node keeping its children in one contiguous array sorted
+   * by their top symbols, which are stored inline next to the child
+   * pointers. Looking up a child by top is a binary search that does not
+   * touch the children themselves, variable children form a prefix of
+   * the array, and the fast retrieval iterators walk the array directly.
+   *
+   * Used instead of SListIntermediateNode in trees created with
+   * the @b compact flag.
+   */
+  class SArrIntermediateNode
+  : public IntermediateNode
+  {
+  public:
+    struct Entry {
+      /** the child, 0 in the entry after the last child */
+      Node* node;
+      /** key of the top symbol of the child's term, see @b topKey() */
+      unsigned top;
+    };
+
+    SArrIntermediateNode(unsigned childVar) : IntermediateNode(childVar), _size(0), _capacity(0), _entries(0) {}
+    SArrIntermediateNode(TermList ts, unsigned childVar) : IntermediateNode(ts, childVar), _size(0), _capacity(0), _entries(0) {}
+
+    ~SArrIntermediateNode();
+
+    static IntermediateNode* assimilate(IntermediateNode* orig);
+
+    void removeAllChildren()
+    {
+      _size=0;
+      if(_entries) {
+        _entries[0].node=0;
+      }
+    }
+
+    inline
+    NodeAlgorithm algorithm() const { return SORTED_ARRAY; }
+    inline
+    bool isEmpty() const { return !_size; }
+    int size() const { return _size; }
+#if VDEBUG
+    virtual void assertValid() const
+    {
+      ASS_ALLOC_TYPE(this,"SubstitutionTree::SArrIntermediateNode");
+    }
+#endif
+
+    /**
+     * Iterator over pointers to the children stored in a range of entries
+     */
+    class EntryPtrIterator
+    {
+    public:
+      DECL_ELEMENT_TYPE(Node**);
+      EntryPtrIterator(Entry* first, Entry* afterLast) : _curr(first), _afterLast(afterLast) {}
+      inline bool hasNext() { return _curr!=_afterLast; }
+      inline Node** next() { return &(_curr++)->node; }
+    private:
+      Entry* _curr;
+      Entry* _afterLast;
+    };
+
+    NodeIterator allChildren()
+    { return pvi( EntryPtrIterator(_entries, _entries+_size) ); }
+    NodeIterator variableChildren()
+    { return pvi( EntryPtrIterator(_entries, _entries+varCount()) ); }
+
+    virtual Node** childByTop(TermList t, bool canCreate);
+    void remove(TermList t);
+
+    /**
+     * Return key of the top symbol of @b t. Keys of variables are smaller
+     * than keys of function symbols, so variable children come first.
+     */
+    inline static unsigned topKey(TermList t)
+    {
+      if(t.isVar()) {
+        ASS_L(t.content(), TERM_KEY_BIT);
+        return static_cast<unsigned>(t.content());
+      }
+      return t.term()->functor() | TERM_KEY_BIT;
+    }
+    inline static bool isVarKey(unsigned key) { return !(key & TERM_KEY_BIT); }
+
+    CLASS_NAME(SubstitutionTree::SArrIntermediateNode);
+    USE_ALLOCATOR(SArrIntermediateNode);
+
+    int _size;
+    int _capacity;
+    /** @b _size children followed by an entry with zero @b node */
+    Entry* _entries;
+
+  private:
+    static const unsigned TERM_KEY_BIT = 0x80000000u;
+
+    int varCount() const;
+    int position(unsigned key, bool& found) const;
+  };
+
   class Binding {
   public:
     /** Number of the variable at this node */
@@ -650,8 +752,28 @@ public:
 
   Leaf* findLeaf(Node* root, BindingMap& svBindings);
 
-  void insert(Node** node,BindingMap& binding,LeafData ld);
-  void remove(Node** node,BindingMap& binding,LeafData ld);
+  void insert(Node** node,BindingMap& binding,LeafData ld)
+  { insert(node,binding,&ld,1); }
+  void remove(Node** node,BindingMap& binding,LeafData ld)
+  { remove(node,binding,&ld,1); }
+  void insert(Node** node,BindingMap& binding,const LeafData* lds,unsigned cnt);
+  void remove(Node** node,BindingMap& binding,const LeafData* lds,unsigned cnt);
+
+  /** Element of a batch of insertions or removals, see @b handleBatch() */
+  struct BatchEntry {
+    BatchEntry() {}
+    BatchEntry(unsigned root, Term* normTerm, LeafData ld)
+    : root(root), normTerm(normTerm), ld(ld) {}
+
+    /** index of the root node in @b _nodes */
+    unsigned root;
+    /** the normalized term or literal being indexed */
+    Term* normTerm;
+    LeafData ld;
+    /** number of the group of entries with the same root and term, set by @b handleBatch() */
+    unsigned group;
+  };
+  void handleBatch(Stack<BatchEntry>& batch, bool insert);
 
   /** Number of the next variable */
   int _nextVar;
@@ -659,6 +781,8 @@ public:
   ZIArray<Node*> _nodes;
   /** enable searching with constraints for this tree */
   bool _useC;
+  /** use SArrIntermediateNode rather than SListIntermediateNode for large nodes */
+  bool _compact;
 
   class LeafIterator
   : public IteratorCore<Leaf*>
@@ -531,6 +531,17 @@ main_loop_start:
 	} else {
 	  sibilingsRemain=false;
 	}
+      } else if(parentType==SORTED_ARRAY) {
+	typedef SArrIntermediateNode::Entry Entry;
+	Entry* alts=static_cast<Entry*>(currAlt);
+	ASS(SArrIntermediateNode::isVarKey(alts->top));
+	curr=(alts++)->node;
+	if(alts->node && SArrIntermediateNode::isVarKey(alts->top)) {
+	  _alternatives.push(alts);
+	  sibilingsRemain=true;
+	} else {
+	  sibilingsRemain=false;
+	}
       } else {
 	ASS_EQ(parentType,SKIP_LIST)
 	NodeList* alts=static_cast<NodeList*>(currAlt);
@@ -666,6 +677,28 @@ bool SubstitutionTree::FastGeneralizationsIterator::enterNode(Node*& curr)
       _nodeTypes.push(currType);
       return true;
     }
+  } else if(currType==SORTED_ARRAY) {
+    typedef SArrIntermediateNode::Entry Entry;
+    Entry* alts=static_cast<SArrIntermediateNode*>(inode)->_entries;
+    if(binding.isTerm()) {
+      Node** byTop=inode->childByTop(binding, false);
+      if(byTop) {
+	curr=*byTop;
+      }
+    }
+    //variables form a prefix of the entries, and their
+    //keys tell us so without looking at the nodes
+    if(!curr && alts->node && SArrIntermediateNode::isVarKey(alts->top)) {
+      curr=(alts++)->node;
+    }
+    if(curr) {
+      _specVarNumbers.push(inode->childVar);
+    }
+    if(alts->node && SArrIntermediateNode::isVarKey(alts->top)) {
+      _alternatives.push(alts);
+      _nodeTypes.push(currType);
+      return true;
+    }
   } else {
     NodeList* nl;
     ASS_EQ(currType, SKIP_LIST);
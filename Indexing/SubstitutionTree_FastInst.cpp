@@ -726,6 +726,16 @@ main_loop_start:
 	} else {
 	  sibilingsRemain=false;
 	}
+      } else if(parentType==SORTED_ARRAY) {
+	typedef SArrIntermediateNode::Entry Entry;
+	Entry* alts=static_cast<Entry*>(currAlt);
+	curr=(alts++)->node;
+	if(alts->node) {
+	  _alternatives.push(alts);
+	  sibilingsRemain=true;
+	} else {
+	  sibilingsRemain=false;
+	}
       } else {
 	ASS_EQ(parentType,SKIP_LIST)
 	NodeList* alts=static_cast<NodeList*>(currAlt);
@@ -863,6 +873,35 @@ bool SubstitutionTree::FastInstancesIterator::enterNode(Node*& curr)
       _nodeTypes.push(currType);
       return true;
     }
+  } else if(currType==SORTED_ARRAY) {
+    typedef SArrIntermediateNode::Entry Entry;
+    Entry* alts=static_cast<SArrIntermediateNode*>(inode)->_entries;
+    ASS(alts->node); //inode is not empty
+    if(query.isTerm()) {
+      //only term with the same top functor will be matched by a term
+      Node** byTop=inode->childByTop(query, false);
+      if(byTop) {
+	curr=*byTop;
+      }
+      alts=0;
+    }
+    else {
+      ASS(query.isVar());
+      //everything is matched by a variable
+      curr=(alts++)->node;
+      if(!alts->node) {
+	alts=0;
+      }
+    }
+
+    if(curr) {
+      _specVarNumbers.push(inode->childVar);
+    }
+    if(alts) {
+      _alternatives.push(alts);
+      _nodeTypes.push(currType);
+      return true;
+    }
   } else {
     NodeList* nl;
     ASS_EQ(currType, SKIP_LIST);
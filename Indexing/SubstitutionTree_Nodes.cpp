@@ -225,6 +225,117 @@ SubstitutionTree::IntermediateNode* SubstitutionTree::SListIntermediateNode
   return res;
 }
 
+const unsigned SubstitutionTree::SArrIntermediateNode::TERM_KEY_BIT;
+
+SubstitutionTree::SArrIntermediateNode::~SArrIntermediateNode()
+{
+  if(!isEmpty()) {
+    destroyChildren();
+  }
+  if(_entries) {
+    DEALLOC_KNOWN(_entries,(_capacity+1)*sizeof(Entry),"SubstitutionTree::SArrIntermediateNode::Entry");
+  }
+}
+
+/**
+ * Return the index of the first child whose key is not smaller than @b key
+ * and set @b found to true iff its key is equal to @b key.
+ */
+int SubstitutionTree::SArrIntermediateNode::position(unsigned key, bool& found) const
+{
+  int lo=0;
+  int hi=_size;
+  while(lo<hi) {
+    int mid=(lo+hi)/2;
+    if(_entries[mid].top<key) {
+      lo=mid+1;
+    } else {
+      hi=mid;
+    }
+  }
+  found = lo<_size && _entries[lo].top==key;
+  return lo;
+}
+
+/** Return the number of variable children, which come first in @b _entries */
+int SubstitutionTree::SArrIntermediateNode::varCount() const
+{
+  bool found;
+  return position(TERM_KEY_BIT, found);
+}
+
+SubstitutionTree::Node** SubstitutionTree::SArrIntermediateNode::
+	childByTop(TermList t, bool canCreate)
+{
+  CALL("SubstitutionTree::SArrIntermediateNode::childByTop");
+
+  unsigned key=topKey(t);
+  bool found;
+  int pos=position(key, found);
+  if(found) {
+    return &_entries[pos].node;
+  }
+  if(!canCreate) {
+    return 0;
+  }
+  mightExistAsTop(t);
+  if(_size==_capacity) {
+    int newCapacity = _capacity ? _capacity*2 : 8;
+    Entry* newEntries = static_cast<Entry*>(
+	ALLOC_KNOWN((newCapacity+1)*sizeof(Entry),"SubstitutionTree::SArrIntermediateNode::Entry"));
+    for(int i=0;i<_size;i++) {
+      newEntries[i]=_entries[i];
+    }
+    if(_entries) {
+      DEALLOC_KNOWN(_entries,(_capacity+1)*sizeof(Entry),"SubstitutionTree::SArrIntermediateNode::Entry");
+    }
+    _entries=newEntries;
+    _capacity=newCapacity;
+  }
+  //shift the following children together with the terminating entry
+  for(int i=_size;i>=pos;i--) {
+    _entries[i+1]=_entries[i];
+  }
+  _size++;
+  _entries[_size].node=0;
+  _entries[pos].node=0;
+  _entries[pos].top=key;
+  return &_entries[pos].node;
+}
+
+void SubstitutionTree::SArrIntermediateNode::remove(TermList t)
+{
+  CALL("SubstitutionTree::SArrIntermediateNode::remove");
+
+  bool found;
+  int pos=position(topKey(t), found);
+  ASS(found);
+  for(int i=pos;i<_size;i++) {
+    _entries[i]=_entries[i+1];
+  }
+  _size--;
+}
+
+/**
+ * Take an IntermediateNode, destroy it, and return
+ * SArrIntermediateNode with the same content.
+ */
+SubstitutionTree::IntermediateNode* SubstitutionTree::SArrIntermediateNode
+	::assimilate(IntermediateNode* orig)
+{
+  CALL("SubstitutionTree::SArrIntermediateNode::assimilate");
+
+  SArrIntermediateNode* res=new SArrIntermediateNode(orig->term, orig->childVar);
+  if(orig->_childBySortHelper) {
+    res->_childBySortHelper=new ChildBySortHelper(res);
+    res->_childBySortHelper->loadFrom(orig->_childBySortHelper);
+  }
+  res->loadChildren(orig->allChildren());
+  orig->makeEmpty();
+  delete orig;
+  return res;
+}
+
 /**
  * Take a Leaf, destroy it, and return SListLeaf
  * with the same content.
@@ -249,12 +360,16 @@ void SubstitutionTree::ensureLeafEfficiency(Leaf** leaf)
   }
 }
 
-void SubstitutionTree::ensureIntermediateNodeEfficiency(IntermediateNode** inode)
+void SubstitutionTree::ensureIntermediateNodeEfficiency(IntermediateNode** inode,bool compact)
 {
   CALL("SubstitutionTree::ensureIntermediateNodeEfficiency");
 
   if( (*inode)->algorithm()==UNSORTED_LIST && (*inode)->size()>3 ) {
-    *inode=SListIntermediateNode::assimilate(*inode);
+    if(compact) {
+      *inode=SArrIntermediateNode::assimilate(*inode);
+    } else {
+      *inode=SListIntermediateNode::assimilate(*inode);
+    }
   }
 }
 
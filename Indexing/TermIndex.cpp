@@ -67,25 +67,38 @@ TermQueryResultIterator TermIndex::getInstances(TermList t,
 }
 
 
+/**
+ * Insert or remove all terms in @b entries as one batch
+ */
+void TermIndex::handleTerms(TermIndexingStructure::EntryStack& entries, bool add)
+{
+  CALL("TermIndex::handleTerms");
+
+  if (add) {
+    _is->insert(entries);
+  }
+  else {
+    _is->remove(entries);
+  }
+}
+
 void SuperpositionSubtermIndex::handleClause(Clause* c, bool adding)
 {
   CALL("SuperpositionSubtermIndex::handleClause");
 
   TimeCounter tc(TC_BACKWARD_SUPERPOSITION_INDEX_MAINTENANCE);
 
+  static TermIndexingStructure::EntryStack entries;
+  entries.reset();
   unsigned selCnt=c->numSelected();
   for (unsigned i=0; i<selCnt; i++) {
     Literal* lit=(*c)[i];
     TermIterator rsti=EqHelper::getRewritableSubtermIterator(lit,_ord);
     while (rsti.hasNext()) {
-      if (adding) {
-	_is->insert(rsti.next(), lit, c);
-      }
-      else {
-	_is->remove(rsti.next(), lit, c);
-      }
+      entries.push(TermIndexingStructure::Entry(rsti.next(), lit, c));
     }
   }
+  handleTerms(entries, adding);
 }
 
 void SuperpositionLHSIndex::handleClause(Clause* c, bool adding)
@@ -94,20 +107,17 @@ void SuperpositionLHSIndex::handleClause(Clause* c, bool adding)
 
   TimeCounter tc(TC_FORWARD_SUPERPOSITION_INDEX_MAINTENANCE);
 
+  static TermIndexingStructure::EntryStack entries;
+  entries.reset();
   unsigned selCnt=c->numSelected();
   for (unsigned i=0; i<selCnt; i++) {
     Literal* lit=(*c)[i];
     TermIterator lhsi=EqHelper::getSuperpositionLHSIterator(lit, _ord, _opt);
     while (lhsi.hasNext()) {
-      TermList lhs=lhsi.next();
-      if (adding) {
-	_is->insert(lhs, lit, c);
-      }
-      else {
-	_is->remove(lhs, lit, c);
-      }
+      entries.push(TermIndexingStructure::Entry(lhsi.next(), lit, c));
     }
   }
+  handleTerms(entries, adding);
 }
 
 void DemodulationSubtermIndex::handleClause(Clause* c, bool adding)
@@ -117,6 +127,8 @@ void DemodulationSubtermIndex::handleClause(Clause* c, bool adding)
   TimeCounter tc(TC_BACKWARD_DEMODULATION_INDEX_MAINTENANCE);
 
   static DHSet<TermList> inserted;
+  static TermIndexingStructure::EntryStack entries;
+  entries.reset();
 
   unsigned cLen=c->length();
   for (unsigned i=0; i<cLen; i++) {
@@ -132,14 +144,10 @@ void DemodulationSubtermIndex::handleClause(Clause* c, bool adding)
 	nvi.right();
 	continue;
       }
-      if (adding) {
-	_is->insert(t, lit, c);
-      }
-      else {
-	_is->remove(t, lit, c);
-      }
+      entries.push(TermIndexingStructure::Entry(t, lit, c));
     }
   }
+  handleTerms(entries, adding);
 }
 
 
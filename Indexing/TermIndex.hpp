@@ -26,6 +26,7 @@
 #define __TermIndex__
 
 #include "Index.hpp"
+#include "TermIndexingStructure.hpp"
 
 namespace Indexing {
 
@@ -50,6 +51,8 @@ public:
 protected:
   TermIndex(TermIndexingStructure* is) : _is(is) {}
 
+  void handleTerms(TermIndexingStructure::EntryStack& entries, bool add);
+
   TermIndexingStructure* _is;
 };
 
@@ -25,6 +25,7 @@
 #ifndef __TermIndexingStructure__
 #define __TermIndexingStructure__
 
+#include "Lib/Stack.hpp"
 #include "Index.hpp"
 
 namespace Indexing {
@@ -36,6 +37,37 @@ public:
   virtual void insert(TermList t, Literal* lit, Clause* cls) = 0;
   virtual void remove(TermList t, Literal* lit, Clause* cls) = 0;
 
+  /** A term of a literal of a clause, for insertion or removal in a batch */
+  struct Entry {
+    Entry() {}
+    Entry(TermList t, Literal* lit, Clause* cls) : term(t), lit(lit), cls(cls) {}
+    TermList term;
+    Literal* lit;
+    Clause* cls;
+  };
+  typedef Stack<Entry> EntryStack;
+
+  /**
+   * Insert all terms in @b entries. Structures that can share work
+   * between the insertions override this. The stack may be reordered.
+   */
+  virtual void insert(EntryStack& entries)
+  {
+    for(unsigned i=0;i<entries.size();i++) {
+      insert(entries[i].term, entries[i].lit, entries[i].cls);
+    }
+  }
+  /**
+   * Remove all terms in @b entries. Structures that can share work
+   * between the removals override this. The stack may be reordered.
+   */
+  virtual void remove(EntryStack& entries)
+  {
+    for(unsigned i=0;i<entries.size();i++) {
+      remove(entries[i].term, entries[i].lit, entries[i].cls);
+    }
+  }
+
   virtual TermQueryResultIterator getUnifications(TermList t,
 	  bool retrieveSubstitutions = true) { NOT_IMPLEMENTED; }
   virtual TermQueryResultIterator getUnificationsWithConstraints(TermList t,
@@ -60,13 +60,15 @@ TermSharing::~TermSharing()
   CALL("TermSharing::~TermSharing");
 
 #if CHECK_LEAKS
-  Set<Term*,TermSharing>::Iterator ts(_terms);
-  while (ts.hasNext()) {
-    ts.next()->destroy();
-  }
-  Set<Literal*,TermSharing>::Iterator ls(_literals);
-  while (ls.hasNext()) {
-    ls.next()->destroy();
+  for (unsigned i = 0; i < SHARDS; i++) {
+    Set<Term*,TermSharing>::Iterator ts(_terms[i]);
+    while (ts.hasNext()) {
+      ts.next()->destroy();
+    }
+    Set<Literal*,TermSharing>::Iterator ls(_literals[i]);
+    while (ls.hasNext()) {
+      ls.next()->destroy();
+    }
   }
 #endif
 }
@@ -96,7 +98,8 @@ Term* TermSharing::insert(Term* t)
   }
 
   _termInsertions++;
-  Term* s = _terms.insert(t);
+  unsigned code = hash(t);
+  Term* s = _terms[shardOf(code)].insertWithHash(t,code);
    if (s == t) {
     unsigned weight = 1;
     unsigned vars = 0;
@@ -178,7 +181,8 @@ Literal* TermSharing::insert(Literal* t)
   }
 
   _literalInsertions++;
-  Literal* s = _literals.insert(t);
+  unsigned code = hash(t);
+  Literal* s = _literals[shardOf(code)].insertWithHash(t,code);
   if (s == t) {
     unsigned weight = 1;
     unsigned vars = 0;
@@ -253,7 +257,8 @@ Literal* TermSharing::insertVariableEquality(Literal* t,unsigned sort)
   t->setTwoVarEqSort(sort);
 
   _literalInsertions++;
-  Literal* s = _literals.insert(t);
+  unsigned code = hash(t);
+  Literal* s = _literals[shardOf(code)].insertWithHash(t,code);
   if (s == t) {
     t->markShared();
     t->setWeight(3);
@@ -314,7 +319,9 @@ Literal* TermSharing::tryGetOpposite(Literal* l)
   CALL("TermSharing::tryGetOpposite");
 
   Literal* res;
-  if(_literals.find(OpLitWrapper(l), res)) {
+  // the opposite literal is stored under the opposite hash
+  OpLitWrapper w(l);
+  if(_literals[shardOf(hash(w))].find(w, res)) {
     return res;
   }
   return 0;
@@ -76,10 +76,24 @@ public:
 private:
   bool argNormGt(TermList t1, TermList t2);
 
-  /** The set storing all terms */
-  Set<Term*,TermSharing> _terms;
-  /** The set storing all literals */
-  Set<Literal*,TermSharing> _literals;
+  /**
+   * Shared terms and literals are spread over this many independent
+   * sets, selected by the top bits of their hash. A set that has to grow
+   * then rehashes only its share of the elements, and the sets are
+   * the natural unit of locking should the sharing ever be used
+   * by more than one thread.
+   */
+  static const unsigned SHARD_BITS = 4;
+  static const unsigned SHARDS = 1u << SHARD_BITS;
+
+  /** Index of the set responsible for elements with the hash @b hash */
+  inline static unsigned shardOf(unsigned hash)
+  { return hash >> (32 - SHARD_BITS); }
+
+  /** The sets storing all terms */
+  Set<Term*,TermSharing> _terms[SHARDS];
+  /** The sets storing all literals */
+  Set<Literal*,TermSharing> _literals[SHARDS];
   /** Number of terms stored */
   unsigned _totalTerms;
   /** Number of ground terms stored */
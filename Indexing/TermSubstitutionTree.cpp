@@ -41,8 +41,8 @@ namespace Indexing
 using namespace Lib;
 using namespace Kernel;
 
-TermSubstitutionTree::TermSubstitutionTree(bool useC)
-: SubstitutionTree(env.signature->functions(),useC)
+TermSubstitutionTree::TermSubstitutionTree(bool useC, bool compact)
+: SubstitutionTree(env.signature->functions(),useC,compact)
 {
 }
 
@@ -92,6 +92,29 @@ void TermSubstitutionTree::handleTerm(TermList t, Literal* lit, Clause* cls, boo
   }
 }
 
+/**
+ * According to value of @b insert, insert or remove all terms
+ * in @b entries, traversing the tree once for each group of terms
+ * that are variants of each other.
+ */
+void TermSubstitutionTree::handleTerms(EntryStack& entries, bool insert)
+{
+  CALL("TermSubstitutionTree::handleTerms");
+
+  static Stack<BatchEntry> batch;
+  batch.reset();
+  for(unsigned i=0;i<entries.size();i++) {
+    Entry& e=entries[i];
+    if(e.term.isOrdinaryVar()) {
+      handleTerm(e.term, e.lit, e.cls, insert);
+      continue;
+    }
+    ASS(e.term.isTerm());
+    Term* normTerm=Renaming::normalize(e.term.term());
+    batch.push(BatchEntry(getRootNodeIndex(normTerm), normTerm, LeafData(e.cls, e.lit, e.term)));
+  }
+  handleBatch(batch, insert);
+}
 
 TermQueryResultIterator TermSubstitutionTree::getUnifications(TermList t,
 	  bool retrieveSubstitutions)
@@ -42,11 +42,14 @@ public:
   CLASS_NAME(TermSubstitutionTree);
   USE_ALLOCATOR(TermSubstitutionTree);
 
-  TermSubstitutionTree(bool useC=false);
+  TermSubstitutionTree(bool useC=false, bool compact=false);
 
   void insert(TermList t, Literal* lit, Clause* cls);
   void remove(TermList t, Literal* lit, Clause* cls);
 
+  void insert(EntryStack& entries) { handleTerms(entries, true); }
+  void remove(EntryStack& entries) { handleTerms(entries, false); }
+
   bool generalizationExists(TermList t);
 
 
@@ -68,6 +71,7 @@ public:
 
 private:
   void handleTerm(TermList t, Literal* lit, Clause* cls, bool insert);
+  void handleTerms(EntryStack& entries, bool insert);
 
   struct TermQueryResultFn;
 
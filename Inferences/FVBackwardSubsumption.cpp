@@ -0,0 +1,147 @@
+
+/*
+ * File FVBackwardSubsumption.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file FVBackwardSubsumption.cpp
+ * Implements class FVBackwardSubsumption.
+ */
+
+#include "Lib/DArray.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/List.hpp"
+#include "Lib/Metaiterators.hpp"
+#include "Lib/TimeCounter.hpp"
+#include "Lib/VirtualIterator.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Matcher.hpp"
+#include "Kernel/MLMatcher.hpp"
+
+#include "Indexing/FeatureVectorIndex.hpp"
+#include "Indexing/IndexManager.hpp"
+
+#include "Saturation/SaturationAlgorithm.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "FVBackwardSubsumption.hpp"
+
+namespace Inferences
+{
+
+using namespace Lib;
+using namespace Kernel;
+using namespace Indexing;
+using namespace Saturation;
+
+void FVBackwardSubsumption::attach(SaturationAlgorithm* salg)
+{
+  CALL("FVBackwardSubsumption::attach");
+  ASS(!_index);
+
+  BackwardSimplificationEngine::attach(salg);
+  _index=static_cast<FeatureVectorIndex*>(
+	  _salg->getIndexManager()->request(FEATURE_VECTOR_SUBSUMPTION_INDEX) );
+}
+
+void FVBackwardSubsumption::detach()
+{
+  CALL("FVBackwardSubsumption::detach");
+  _index=0;
+  _salg->getIndexManager()->release(FEATURE_VECTOR_SUBSUMPTION_INDEX);
+  BackwardSimplificationEngine::detach();
+}
+
+struct FVBackwardSubsumption::ClauseToBwSimplRecordFn
+{
+  DECL_RETURN_TYPE(BwSimplificationRecord);
+  OWN_RETURN_TYPE operator()(Clause* cl)
+  {
+    return BwSimplificationRecord(cl);
+  }
+};
+
+void FVBackwardSubsumption::perform(Clause* cl,
+	BwSimplificationRecordIterator& simplifications)
+{
+  CALL("FVBackwardSubsumption::perform");
+  ASSERT_VALID(*cl);
+
+  TimeCounter tc(TC_BACKWARD_SUBSUMPTION);
+
+  simplifications=BwSimplificationRecordIterator::getEmpty();
+
+  unsigned clen=cl->length();
+  if(_byUnitsOnly && clen>1) {
+    return;
+  }
+
+  static ClauseStack candidates;
+  candidates.reset();
+  _index->getSubsumedCandidates(cl, candidates);
+
+  static DArray<LiteralList*> matchedLits(32);
+  matchedLits.init(clen, 0);
+
+  ClauseList* subsumed=0;
+
+  ClauseStack::BottomFirstIterator cit(candidates);
+  while(cit.hasNext()) {
+    Clause* icl=cit.next();
+    unsigned ilen=icl->length();
+    if(icl==cl) {
+      continue;
+    }
+    //the features bound the number of literals of each polarity
+    ASS_GE(ilen,clen);
+
+    bool isSubsumed=true;
+    if(clen>0) {
+      for(unsigned bi=0;bi<clen;bi++) {
+	for(unsigned ii=0;ii<ilen;ii++) {
+	  if(MatchingUtils::match((*cl)[bi],(*icl)[ii],false)) {
+	    LiteralList::push((*icl)[ii], matchedLits[bi]);
+	  }
+	}
+	if(!matchedLits[bi]) {
+	  isSubsumed=false;
+	  break;
+	}
+      }
+      isSubsumed=isSubsumed && MLMatcher::canBeMatched(cl,icl,matchedLits.array(),0);
+
+      for(unsigned bi=0; bi<clen; bi++) {
+	LiteralList::destroy(matchedLits[bi]);
+	matchedLits[bi]=0;
+      }
+    }
+
+    if(isSubsumed) {
+      ClauseList::push(icl, subsumed);
+      env.statistics->backwardSubsumed++;
+    }
+  }
+
+  if(subsumed) {
+    simplifications=getPersistentIterator(
+	    getMappingIterator(ClauseList::Iterator(subsumed), ClauseToBwSimplRecordFn()));
+    ClauseList::destroy(subsumed);
+  }
+}
+
+}
@@ -0,0 +1,61 @@
+
+/*
+ * File FVBackwardSubsumption.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file FVBackwardSubsumption.hpp
+ * Defines class FVBackwardSubsumption.
+ */
+
+#ifndef __FVBackwardSubsumption__
+#define __FVBackwardSubsumption__
+
+#include "Forwards.hpp"
+
+#include "InferenceEngine.hpp"
+
+namespace Inferences {
+
+using namespace Indexing;
+
+/**
+ * Backward subsumption that retrieves the candidate subsumed clauses
+ * from a FeatureVectorIndex
+ */
+class FVBackwardSubsumption
+: public BackwardSimplificationEngine
+{
+public:
+  CLASS_NAME(FVBackwardSubsumption);
+  USE_ALLOCATOR(FVBackwardSubsumption);
+
+  FVBackwardSubsumption(bool byUnitsOnly) : _byUnitsOnly(byUnitsOnly), _index(0) {}
+
+  void attach(SaturationAlgorithm* salg);
+  void detach();
+
+  void perform(Clause* premise, BwSimplificationRecordIterator& simplifications);
+private:
+  struct ClauseToBwSimplRecordFn;
+
+  bool _byUnitsOnly;
+  FeatureVectorIndex* _index;
+};
+
+};
+
+#endif /* __FVBackwardSubsumption__ */
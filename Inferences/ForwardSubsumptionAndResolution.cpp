@@ -36,6 +36,7 @@
 #include "Kernel/MLMatcher.hpp"
 #include "Kernel/ColorHelper.hpp"
 
+#include "Indexing/FeatureVectorIndex.hpp"
 #include "Indexing/Index.hpp"
 #include "Indexing/LiteralIndex.hpp"
 #include "Indexing/LiteralMiniIndex.hpp"
@@ -63,17 +64,30 @@ void ForwardSubsumptionAndResolution::attach(SaturationAlgorithm* salg)
   ForwardSimplificationEngine::attach(salg);
   _unitIndex=static_cast<UnitClauseLiteralIndex*>(
 	  _salg->getIndexManager()->request(SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE) );
-  _fwIndex=static_cast<FwSubsSimplifyingLiteralIndex*>(
-	  _salg->getIndexManager()->request(FW_SUBSUMPTION_SUBST_TREE) );
+  if(_salg->getOptions().subsumptionIndex()==Options::SubsumptionIndex::FEATURE_VECTOR) {
+    _fvIndex=static_cast<FeatureVectorIndex*>(
+	    _salg->getIndexManager()->request(FEATURE_VECTOR_SUBSUMPTION_INDEX) );
+  }
+  //subsumption resolution needs the literal index even with the feature vector index
+  if(!_fvIndex || _subsumptionResolution) {
+    _fwIndex=static_cast<FwSubsSimplifyingLiteralIndex*>(
+	    _salg->getIndexManager()->request(FW_SUBSUMPTION_SUBST_TREE) );
+  }
 }
 
 void ForwardSubsumptionAndResolution::detach()
 {
   CALL("ForwardSubsumptionAndResolution::detach");
   _unitIndex=0;
-  _fwIndex=0;
   _salg->getIndexManager()->release(SIMPLIFYING_UNIT_CLAUSE_SUBST_TREE);
-  _salg->getIndexManager()->release(FW_SUBSUMPTION_SUBST_TREE);
+  if(_fwIndex) {
+    _fwIndex=0;
+    _salg->getIndexManager()->release(FW_SUBSUMPTION_SUBST_TREE);
+  }
+  if(_fvIndex) {
+    _fvIndex=0;
+    _salg->getIndexManager()->release(FEATURE_VECTOR_SUBSUMPTION_INDEX);
+  }
   ForwardSimplificationEngine::detach();
 }
 
@@ -187,6 +201,30 @@ bool isSubsumed(Clause* cl, CMStack& cmStore)
   return false;
 }
 
+/**
+ * Return true if the non-unit clause @b mcl subsumes @b cl, whose literals
+ * are in @b miniIndex. The literal matches of @b mcl are stored in its aux
+ * field and in @b cmStore, so that they can be reused for subsumption
+ * resolution.
+ */
+bool isSubsumedBy(Clause* cl, Clause* mcl, LiteralMiniIndex& miniIndex, CMStack& cmStore)
+{
+  CALL("isSubsumedBy");
+
+  ClauseMatches* cms=new ClauseMatches(mcl);
+  mcl->setAux(cms);
+  cmStore.push(cms);
+  //      cms->addMatch(res.literal, (*cl)[li]);
+  //      cms->fillInMatches(&miniIndex, res.literal, (*cl)[li]);
+  cms->fillInMatches(&miniIndex);
+
+  if(cms->anyNonMatched()) {
+    return false;
+  }
+
+  return MLMatcher::canBeMatched(mcl,cl,cms->_matches,0) && ColorHelper::compatible(cl->color(), mcl->color());
+}
+
 Clause* ForwardSubsumptionAndResolution::generateSubsumptionResolutionClause(Clause* cl, Literal* lit, Clause* baseClause)
 {
   CALL("ForwardSubsumptionAndResolution::generateSubsumptionResolutionClause");
@@ -289,30 +327,19 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
   {
   LiteralMiniIndex miniIndex(cl);
 
-  for(unsigned li=0;li<clen;li++) {
-    SLQueryResultIterator rit=_fwIndex->getGeneralizations( (*cl)[li], false, false);
-    while(rit.hasNext()) {
-      SLQueryResult res=rit.next();
-      Clause* mcl=res.clause;
-      if(mcl->hasAux()) {
-	//we've already checked this clause
-	continue;
-      }
-      unsigned mlen=mcl->length();
-      ASS_G(mlen,1);
+  if(_fvIndex) {
+    static ClauseStack candidates;
+    candidates.reset();
+    _fvIndex->getSubsumingCandidates(cl, candidates);
 
-      ClauseMatches* cms=new ClauseMatches(mcl);
-      mcl->setAux(cms);
-      cmStore.push(cms);
-      //      cms->addMatch(res.literal, (*cl)[li]);
-      //      cms->fillInMatches(&miniIndex, res.literal, (*cl)[li]);
-      cms->fillInMatches(&miniIndex);
-
-      if(cms->anyNonMatched()) {
+    ClauseStack::BottomFirstIterator cit(candidates);
+    while(cit.hasNext()) {
+      Clause* mcl=cit.next();
+      //unit clauses were already checked using the unit index
+      if(mcl->length()==1 || mcl->hasAux()) {
 	continue;
       }
-
-      if(MLMatcher::canBeMatched(mcl,cl,cms->_matches,0) && ColorHelper::compatible(cl->color(), mcl->color())) {
+      if(isSubsumedBy(cl, mcl, miniIndex, cmStore)) {
         premises = pvi( getSingletonIterator(mcl) );
         env.statistics->forwardSubsumed++;
         result = true;
@@ -320,6 +347,27 @@ bool ForwardSubsumptionAndResolution::perform(Clause* cl, Clause*& replacement,
       }
     }
   }
+  else {
+    for(unsigned li=0;li<clen;li++) {
+      SLQueryResultIterator rit=_fwIndex->getGeneralizations( (*cl)[li], false, false);
+      while(rit.hasNext()) {
+        SLQueryResult res=rit.next();
+        Clause* mcl=res.clause;
+        if(mcl->hasAux()) {
+	  //we've already checked this clause
+	  continue;
+        }
+        ASS_G(mcl->length(),1);
+
+        if(isSubsumedBy(cl, mcl, miniIndex, cmStore)) {
+          premises = pvi( getSingletonIterator(mcl) );
+          env.statistics->forwardSubsumed++;
+          result = true;
+          goto fin;
+        }
+      }
+    }
+  }
 
   tc_fs.stop();
 
@@ -43,7 +43,7 @@ public:
   USE_ALLOCATOR(ForwardSubsumptionAndResolution);
 
   ForwardSubsumptionAndResolution(bool subsumptionResolution=true)
-  : _subsumptionResolution(subsumptionResolution) {}
+  : _fwIndex(0), _fvIndex(0), _subsumptionResolution(subsumptionResolution) {}
 
   void attach(SaturationAlgorithm* salg) override;
   void detach() override;
@@ -53,7 +53,10 @@ public:
 private:
   /** Simplification unit index */
   UnitClauseLiteralIndex* _unitIndex;
+  /** Index of non-unit clauses by literals, zero if not needed */
   FwSubsSimplifyingLiteralIndex* _fwIndex;
+  /** Index retrieving non-unit subsuming clauses if the feature vector index is used, otherwise zero */
+  FeatureVectorIndex* _fvIndex;
 
   bool _subsumptionResolution;
 };
@@ -47,6 +47,7 @@
 #include "TermIterators.hpp"
 
 #include "Clause.hpp"
+#include "ClauseArena.hpp"
 
 #undef RSTAT_COLLECTION
 #define RSTAT_COLLECTION 1
@@ -132,7 +133,7 @@ void* Clause::operator new(size_t sz, unsigned lits)
   size_t size = sizeof(Clause) + lits * sizeof(Literal*);
   size -= sizeof(Literal*);
 
-  return ALLOC_KNOWN(size,"Clause");
+  return ClauseArena::allocate(lits,size);
 }
 
 void Clause::operator delete(void* ptr,unsigned length)
@@ -147,7 +148,7 @@ void Clause::operator delete(void* ptr,unsigned length)
   size_t size = sizeof(Clause) + length * sizeof(Literal*);
   size -= sizeof(Literal*);
 
-  DEALLOC_KNOWN(ptr, size,"Clause");
+  ClauseArena::deallocate(ptr,length,size);
 }
 
 void Clause::destroyExceptInferenceObject()
@@ -164,7 +165,7 @@ void Clause::destroyExceptInferenceObject()
   size_t size = sizeof(Clause) + _length * sizeof(Literal*);
   size -= sizeof(Literal*);
 
-  DEALLOC_KNOWN(this, size,"Clause");
+  ClauseArena::deallocate(this,_length,size);
 }
 
 
@@ -743,7 +744,7 @@ void Clause::notifyLiteralReorder()
 
 void Clause::assertValid()
 {
-  ASS_ALLOC_TYPE(this, "Clause");
+  ClauseArena::assertValid(this, _length);
   if (_literalPositions) {
     unsigned clen=length();
     for (unsigned i = 0; i<clen; i++) {
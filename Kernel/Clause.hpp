@@ -214,6 +214,7 @@ public:
   bool shouldBeDestroyed();
   void destroyIfUnnecessary();
 
+  unsigned refCnt() const { return _refCnt; }
   void incRefCnt() { _refCnt++; }
   void decRefCnt()
   {
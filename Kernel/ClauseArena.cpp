@@ -0,0 +1,230 @@
+
+/*
+ * File ClauseArena.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ClauseArena.cpp
+ * Implements class ClauseArena.
+ */
+
+#include "Debug/Assertion.hpp"
+#include "Debug/Tracer.hpp"
+
+#include "Lib/Allocator.hpp"
+
+#include "ClauseArena.hpp"
+
+#ifndef USE_SYSTEM_ALLOCATION
+#define USE_SYSTEM_ALLOCATION 0
+#endif
+
+namespace Kernel
+{
+
+const unsigned ClauseArena::MAX_LENGTH;
+const size_t ClauseArena::SLAB_SIZE;
+const unsigned ClauseArena::MAX_SLABS;
+
+ClauseArena::Slab* ClauseArena::s_current[MAX_LENGTH+1];
+ClauseArena::Slab* ClauseArena::s_partial[MAX_LENGTH+1];
+unsigned ClauseArena::s_slabCnt[MAX_LENGTH+1];
+ClauseArena::Slab* ClauseArena::s_empty = 0;
+
+/**
+ * Return memory of @b size bytes for a clause of length @b length
+ */
+void* ClauseArena::allocate(unsigned length, size_t size)
+{
+  CALL("ClauseArena::allocate");
+
+  if(USE_SYSTEM_ALLOCATION || length>MAX_LENGTH) {
+    return ALLOC_KNOWN(size,"Clause");
+  }
+
+  Slab* s = s_current[length];
+  if(!s || s->full()) {
+    if(s_partial[length]) {
+      s = s_partial[length];
+      unlinkPartial(s);
+    }
+    else if(s_slabCnt[length]<MAX_SLABS) {
+      s = newSlab(length, size);
+    }
+    else {
+      char* mem = static_cast<char*>(ALLOC_KNOWN(size+sizeof(Slab*),"Clause"));
+      *reinterpret_cast<Slab**>(mem) = 0;
+      return mem+sizeof(Slab*);
+    }
+    s_current[length] = s;
+  }
+  ASS_EQ(s->slotSize, size+sizeof(Slab*));
+
+  void* res;
+  if(s->freeSlots) {
+    res = s->freeSlots;
+    s->freeSlots = s->freeSlots->next;
+  }
+  else {
+    char* slot = s->slot(s->used++);
+    *reinterpret_cast<Slab**>(slot) = s;
+    res = slot+sizeof(Slab*);
+  }
+  s->live++;
+  return res;
+}
+
+/**
+ * Release memory of a clause of length @b length obtained from @b allocate()
+ */
+void ClauseArena::deallocate(void* obj, unsigned length, size_t size)
+{
+  CALL("ClauseArena::deallocate");
+
+  if(USE_SYSTEM_ALLOCATION || length>MAX_LENGTH) {
+    DEALLOC_KNOWN(obj,size,"Clause");
+    return;
+  }
+
+  Slab* s = *(reinterpret_cast<Slab**>(obj)-1);
+  if(!s) {
+    DEALLOC_KNOWN(reinterpret_cast<Slab**>(obj)-1,size+sizeof(Slab*),"Clause");
+    return;
+  }
+  ASS_EQ(s->length, length);
+  ASS_G(s->live, 0);
+
+  FreeSlot* fs = static_cast<FreeSlot*>(obj);
+  fs->next = s->freeSlots;
+  s->freeSlots = fs;
+  s->live--;
+
+  if(s==s_current[length]) {
+    return;
+  }
+  if(s->live==0) {
+    if(s->inPartial) {
+      unlinkPartial(s);
+    }
+    s_slabCnt[length]--;
+    s->next = s_empty;
+    s_empty = s;
+  }
+  else if(!s->inPartial) {
+    linkPartial(s);
+  }
+}
+
+/**
+ * Return slabs that no longer contain any live clause to the global allocator
+ *
+ * Called once per iteration of the saturation loop, so that slabs emptied
+ * and refilled within one iteration do not go through the global allocator.
+ */
+void ClauseArena::endEpoch()
+{
+  CALL("ClauseArena::endEpoch");
+
+  while(s_empty) {
+    Slab* s = s_empty;
+    s_empty = s->next;
+    DEALLOC_KNOWN(s, SLAB_SIZE, "ClauseArena::Slab");
+  }
+}
+
+#if VDEBUG
+/**
+ * Check that @b obj is memory of a clause of length @b length
+ * obtained from @b allocate()
+ */
+void ClauseArena::assertValid(const void* obj, unsigned length)
+{
+  if(USE_SYSTEM_ALLOCATION || length>MAX_LENGTH) {
+    ASS_ALLOC_TYPE(obj, "Clause");
+    return;
+  }
+  const Slab* s = *(reinterpret_cast<Slab* const*>(obj)-1);
+  if(!s) {
+    ASS_ALLOC_TYPE(reinterpret_cast<Slab* const*>(obj)-1, "Clause");
+    return;
+  }
+  ASS_ALLOC_TYPE(s, "ClauseArena::Slab");
+  ASS_EQ(s->length, length);
+  ASS_G(s->live, 0);
+}
+#endif
+
+ClauseArena::Slab* ClauseArena::newSlab(unsigned length, size_t size)
+{
+  CALL("ClauseArena::newSlab");
+
+  Slab* s;
+  if(s_empty) {
+    s = s_empty;
+    s_empty = s->next;
+  }
+  else {
+    s = static_cast<Slab*>(ALLOC_KNOWN(SLAB_SIZE, "ClauseArena::Slab"));
+  }
+  s->prev = 0;
+  s->next = 0;
+  s->freeSlots = 0;
+  s->length = length;
+  s->slotSize = size+sizeof(Slab*);
+  s->capacity = (SLAB_SIZE-sizeof(Slab))/s->slotSize;
+  s->used = 0;
+  s->live = 0;
+  s->inPartial = false;
+  ASS_G(s->capacity, 0);
+  s_slabCnt[length]++;
+  return s;
+}
+
+void ClauseArena::linkPartial(Slab* s)
+{
+  CALL("ClauseArena::linkPartial");
+  ASS(!s->inPartial);
+
+  Slab*& head = s_partial[s->length];
+  s->prev = 0;
+  s->next = head;
+  if(head) {
+    head->prev = s;
+  }
+  head = s;
+  s->inPartial = true;
+}
+
+void ClauseArena::unlinkPartial(Slab* s)
+{
+  CALL("ClauseArena::unlinkPartial");
+  ASS(s->inPartial);
+
+  if(s->prev) {
+    s->prev->next = s->next;
+  }
+  else {
+    s_partial[s->length] = s->next;
+  }
+  if(s->next) {
+    s->next->prev = s->prev;
+  }
+  s->prev = 0;
+  s->next = 0;
+  s->inPartial = false;
+}
+
+}
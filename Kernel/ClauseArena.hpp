@@ -0,0 +1,112 @@
+
+/*
+ * File ClauseArena.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ClauseArena.hpp
+ * Defines class ClauseArena.
+ */
+
+#ifndef __ClauseArena__
+#define __ClauseArena__
+
+#include <cstddef>
+
+#include "Forwards.hpp"
+
+namespace Kernel {
+
+/**
+ * Slab allocator for the memory of short clauses.
+ *
+ * Clauses of the same length are carved from shared slabs, so clauses
+ * created close to each other in time also lie close to each other in
+ * memory. Each slab counts its live clauses; a slab whose clauses have
+ * all been deleted is kept until the end of the current saturation
+ * epoch (see @b endEpoch()) and then returned to the global allocator
+ * in bulk, so it can be reused for clauses of any length or for other
+ * objects.
+ *
+ * Slabs are not compacted, so a slab that keeps a single live clause
+ * keeps all its memory. To bound this waste, there are at most
+ * @b MAX_SLABS slabs with live clauses of each length. When they are all
+ * full, further clauses of that length come from the global allocator.
+ *
+ * Every clause in a slab is preceded by a pointer to its slab, and every
+ * clause of length at most @b MAX_LENGTH from the global allocator by
+ * a null pointer.
+ */
+class ClauseArena {
+public:
+  /** Clauses longer than this are allocated directly by the global allocator */
+  static const unsigned MAX_LENGTH = 24;
+  /** Size of a slab in bytes, including its header */
+  static const size_t SLAB_SIZE = 16384;
+  /** Maximal number of slabs with live clauses of one length */
+  static const unsigned MAX_SLABS = 256;
+
+  static void* allocate(unsigned length, size_t size);
+  static void deallocate(void* obj, unsigned length, size_t size);
+  static void endEpoch();
+
+#if VDEBUG
+  static void assertValid(const void* obj, unsigned length);
+#endif
+
+private:
+  struct Slab;
+
+  /** A free slot, linked through the memory of the deleted clause */
+  struct FreeSlot {
+    FreeSlot* next;
+  };
+
+  struct Slab {
+    /** Neighbours in the list of partially used slabs of the same length,
+     * or in the list of empty slabs (only @b next is used there) */
+    Slab* prev;
+    Slab* next;
+    FreeSlot* freeSlots;
+    unsigned length;
+    unsigned slotSize;
+    unsigned capacity;
+    /** Number of slots ever handed out from this slab */
+    unsigned used;
+    unsigned live;
+    bool inPartial;
+
+    char* slot(unsigned i) { return reinterpret_cast<char*>(this+1)+i*slotSize; }
+    bool full() const { return !freeSlots && used==capacity; }
+  };
+
+  static Slab* newSlab(unsigned length, size_t size);
+  static void linkPartial(Slab* s);
+  static void unlinkPartial(Slab* s);
+
+  /** Slab currently being filled, for each clause length */
+  static Slab* s_current[MAX_LENGTH+1];
+  /** Slabs with free slots other than the current one, for each clause length */
+  static Slab* s_partial[MAX_LENGTH+1];
+  /** Number of slabs with live clauses (or being filled), for each clause length */
+  static unsigned s_slabCnt[MAX_LENGTH+1];
+  /** Slabs without live clauses, released by @b endEpoch() */
+  static Slab* s_empty;
+};
+
+}
+
+#endif // __ClauseArena__
@@ -250,6 +250,8 @@ vstring Inference::ruleName(Rule rule)
     return "input";
   case NEGATED_CONJECTURE:
     return "negated conjecture";
+  case PROBLEM_CACHE:
+    return "loaded from problem cache";
   case ANSWER_LITERAL:
     return "answer literal";
   case RECTIFY:
@@ -51,6 +51,8 @@ public:
     INPUT,
     /** negated conjecture from the input */
     NEGATED_CONJECTURE,
+    /** preprocessed clause read back from a problem cache file */
+    PROBLEM_CACHE,
     /** introduction of answer literal into the conjecture,
      * or the unit negation of answer literal used to obtain refutation */
     ANSWER_LITERAL,
@@ -388,6 +388,81 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   Term* t1=tl1.term();
   Term* t2=tl2.term();
 
+  if(t1->shared() && t2->shared()) {
+    return compareShared(t1,t2);
+  }
+  return compareByTraversal(t1,t2);
+}
+
+/**
+ * If the comparison of shared terms @b t1 and @b t2 can be decided
+ * only from their cached weights and numbers of variable occurrences,
+ * assign the result to @b res and return true. Otherwise return false.
+ *
+ * The cached weight of a shared term is the KBO weight when all symbols
+ * and variables weigh one, which holds unless colored symbols are used.
+ */
+bool KBO::compareByWeights(Term* t1, Term* t2, Result& res) const
+{
+  CALL("KBO::compareByWeights");
+  ASS(t1->shared());
+  ASS(t2->shared());
+
+  if(env.colorUsed) {
+    return false;
+  }
+  unsigned w1=t1->weight();
+  unsigned w2=t2->weight();
+  if(w1==w2) {
+    return false;
+  }
+  if(w1<w2) {
+    swap(t1,t2);
+  }
+  //now t1 is the heavier term
+  if(t1->vars()<t2->vars()) {
+    //some variable occurs more times in the lighter term
+    res=INCOMPARABLE;
+    return true;
+  }
+  if(t2->ground()) {
+    res=w1>w2 ? GREATER : LESS;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Compare shared terms @b t1 and @b t2, first by their cached weights,
+ * then by looking into the comparison cache of the ordering and only
+ * then by traversing them.
+ */
+Ordering::Result KBO::compareShared(Term* t1, Term* t2) const
+{
+  CALL("KBO::compareShared");
+
+  Result res;
+  if(compareByWeights(t1,t2,res)) {
+    ASS_EQ(res, compareByTraversal(t1,t2));
+    return res;
+  }
+
+  if(findCachedComparison(t1,t2,res)) {
+    ASS_EQ(res, compareByTraversal(t1,t2));
+    return res;
+  }
+  res=compareByTraversal(t1,t2);
+  cacheComparison(t1,t2,res);
+  return res;
+}
+
+/**
+ * Compare non-variable terms @b t1 and @b t2 by traversing them
+ */
+Ordering::Result KBO::compareByTraversal(Term* t1, Term* t2) const
+{
+  CALL("KBO::compareByTraversal");
+
   ASS(_state);
   State* state=_state;
 #if VDEBUG
@@ -399,8 +474,8 @@ Ordering::Result KBO::compare(TermList tl1, TermList tl2) const
   if(t1->functor()==t2->functor()) {
     state->traverse(t1,t2);
   } else {
-    state->traverse(tl1,1);
-    state->traverse(tl2,-1);
+    state->traverse(TermList(t1),1);
+    state->traverse(TermList(t2),-1);
   }
   Result res=state->result(t1,t2);
 #if VDEBUG
@@ -56,6 +56,11 @@ protected:
   Result comparePredicates(Literal* l1, Literal* l2) const override;
 
   class State;
+
+  bool compareByWeights(Term* t1, Term* t2, Result& res) const;
+  Result compareShared(Term* t1, Term* t2) const;
+  Result compareByTraversal(Term* t1, Term* t2) const;
+
   /** Weight of variables */
   int _variableWeight;
   /** Weight of function symbols not occurring in the
@@ -32,12 +32,14 @@
 #include "Lib/List.hpp"
 #include "Lib/SmartPtr.hpp"
 #include "Lib/DHMap.hpp"
+#include "Lib/Hash.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Metaiterators.hpp"
 #include "Lib/Random.hpp"
 
 #include "Shell/Options.hpp"
 #include "Shell/Property.hpp"
+#include "Shell/Statistics.hpp"
 
 #include "LPO.hpp"
 #include "KBO.hpp"
@@ -52,17 +54,198 @@
 #define NONINTERPRETED_LEVEL_BOOST 0x1000
 #define COLORED_LEVEL_BOOST 0x10000
 
+/** Number of comparison results kept by the comparison cache */
+#define COMPARISON_CACHE_CAPACITY 0x10000
+
 using namespace Lib;
 using namespace Kernel;
 
 OrderingSP Ordering::s_globalOrdering;
 
+/**
+ * Comparison results of pairs of shared terms, evicting the least recently
+ * used result when full.
+ *
+ * Shared terms are never deleted, so their addresses identify them for
+ * the lifetime of the ordering. The entries are kept in an array and
+ * linked into a list from the most to the least recently used one.
+ *
+ * The entries are found through an open addressing table of entry indices
+ * with linear probing. Evicting an entry removes its index by shifting the
+ * following indices of the probe sequence back, so the table never fills
+ * up with deleted slots however many entries are evicted.
+ */
+class Ordering::ComparisonCache
+{
+public:
+  CLASS_NAME(Ordering::ComparisonCache);
+  USE_ALLOCATOR(ComparisonCache);
+
+  ComparisonCache(unsigned capacity)
+  : _capacity(capacity), _size(0), _first(NIL), _last(NIL), _entries(capacity),
+    _mask(tableSize(capacity)-1), _table(_mask+1)
+  {
+    for(unsigned i=0;i<=_mask;i++) {
+      _table[i]=NIL;
+    }
+  }
+
+  bool find(Term* t1, Term* t2, Result& res)
+  {
+    CALL("Ordering::ComparisonCache::find");
+
+    unsigned idx=_table[findSlot(t1,t2)];
+    if(idx==NIL) {
+      return false;
+    }
+    if(idx!=_first) {
+      unlink(idx);
+      pushFirst(idx);
+    }
+    res=_entries[idx].res;
+    return true;
+  }
+
+  void insert(Term* t1, Term* t2, Result res)
+  {
+    CALL("Ordering::ComparisonCache::insert");
+
+    unsigned idx;
+    if(_size<_capacity) {
+      idx=_size++;
+    } else {
+      idx=_last;
+      unlink(idx);
+      removeSlot(findSlot(_entries[idx].t1,_entries[idx].t2));
+    }
+    Entry& e=_entries[idx];
+    e.t1=t1;
+    e.t2=t2;
+    e.res=res;
+    unsigned slot=findSlot(t1,t2);
+    ASS_EQ(_table[slot],NIL);
+    _table[slot]=idx;
+    pushFirst(idx);
+  }
+
+private:
+  enum { NIL=0xFFFFFFFFu };
+
+  struct Entry
+  {
+    Term* t1;
+    Term* t2;
+    Result res;
+    /** Index of the more recently used entry, or NIL */
+    unsigned prev;
+    /** Index of the less recently used entry, or NIL */
+    unsigned next;
+  };
+
+  /** Smallest power of two that keeps the table at most half full */
+  static unsigned tableSize(unsigned capacity)
+  {
+    unsigned res=1;
+    while(res<2*capacity) {
+      res<<=1;
+    }
+    return res;
+  }
+
+  unsigned hash(Term* t1, Term* t2) const
+  {
+    return HashUtils::combine(Hash::hash(t1), Hash::hash(t2)) & _mask;
+  }
+
+  /**
+   * Return the slot of the table that holds the entry of @b t1 and @b t2,
+   * or the empty slot where it would be inserted
+   */
+  unsigned findSlot(Term* t1, Term* t2) const
+  {
+    unsigned slot=hash(t1,t2);
+    for(;;) {
+      unsigned idx=_table[slot];
+      if(idx==NIL || (_entries[idx].t1==t1 && _entries[idx].t2==t2)) {
+        return slot;
+      }
+      slot=(slot+1) & _mask;
+    }
+  }
+
+  /**
+   * Empty the occupied slot @b slot and move back the indices that
+   * could not be placed into it when it was occupied
+   */
+  void removeSlot(unsigned slot)
+  {
+    ASS_NEQ(_table[slot],NIL);
+
+    unsigned next=slot;
+    for(;;) {
+      next=(next+1) & _mask;
+      unsigned idx=_table[next];
+      if(idx==NIL) {
+        break;
+      }
+      unsigned home=hash(_entries[idx].t1,_entries[idx].t2);
+      //the index can fill the gap if its probe sequence from home passes it
+      if(((next-home) & _mask) >= ((next-slot) & _mask)) {
+        _table[slot]=idx;
+        slot=next;
+      }
+    }
+    _table[slot]=NIL;
+  }
+
+  void unlink(unsigned idx)
+  {
+    Entry& e=_entries[idx];
+    if(e.prev==NIL) {
+      _first=e.next;
+    } else {
+      _entries[e.prev].next=e.next;
+    }
+    if(e.next==NIL) {
+      _last=e.prev;
+    } else {
+      _entries[e.next].prev=e.prev;
+    }
+  }
+
+  void pushFirst(unsigned idx)
+  {
+    Entry& e=_entries[idx];
+    e.prev=NIL;
+    e.next=_first;
+    if(_first==NIL) {
+      _last=idx;
+    } else {
+      _entries[_first].prev=idx;
+    }
+    _first=idx;
+  }
+
+  unsigned _capacity;
+  unsigned _size;
+  /** The most recently used entry */
+  unsigned _first;
+  /** The least recently used entry */
+  unsigned _last;
+  DArray<Entry> _entries;
+  /** Size of @b _table minus one, the table size being a power of two */
+  unsigned _mask;
+  /** Indices of the entries in @b _entries, NIL for empty slots */
+  DArray<unsigned> _table;
+};
+
 Ordering::Ordering()
 {
   CALL("Ordering::Ordering");
 
   createEqualityComparator();
   ASS(_eqCmp);
+  _comparisonCache=new ComparisonCache(COMPARISON_CACHE_CAPACITY);
 }
 
 Ordering::~Ordering()
@@ -70,6 +253,37 @@ Ordering::~Ordering()
   CALL("Ordering::~Ordering");
 
   destroyEqualityComparator();
+  delete _comparisonCache;
+}
+
+/**
+ * If the result of comparing shared terms @b t1 and @b t2 is cached,
+ * assign it to @b res and return true. Otherwise return false.
+ */
+bool Ordering::findCachedComparison(Term* t1, Term* t2, Result& res) const
+{
+  CALL("Ordering::findCachedComparison");
+  ASS(t1->shared());
+  ASS(t2->shared());
+
+  if(_comparisonCache->find(t1,t2,res)) {
+    env.statistics->orderingCacheHits++;
+    return true;
+  }
+  env.statistics->orderingCacheMisses++;
+  return false;
+}
+
+/**
+ * Remember @b res as the result of comparing shared terms @b t1 and @b t2
+ */
+void Ordering::cacheComparison(Term* t1, Term* t2, Result res) const
+{
+  CALL("Ordering::cacheComparison");
+  ASS(t1->shared());
+  ASS(t2->shared());
+
+  _comparisonCache->insert(t1,t2,res);
 }
 
 
@@ -115,6 +115,9 @@ protected:
 
   Result compareEqualities(Literal* eq1, Literal* eq2) const;
 
+  bool findCachedComparison(Term* t1, Term* t2, Result& res) const;
+  void cacheComparison(Term* t1, Term* t2, Result res) const;
+
 private:
 
   enum ArgumentOrderVals {
@@ -147,6 +150,10 @@ private:
   /** Object used to compare equalities */
   EqCmp* _eqCmp;
 
+  class ComparisonCache;
+  /** Bounded cache of comparison results of shared terms */
+  ComparisonCache* _comparisonCache;
+
   /**
    * We store orientation of equalities in this ordering inside
    * the term sharing structure. Setting an ordering to be global
@@ -61,6 +61,17 @@ const int RobSubstitution::AUX_INDEX=-3;
 const int RobSubstitution::SPECIAL_INDEX=-2;
 const int RobSubstitution::UNBOUND_INDEX=-1;
 
+RobSubstitution::~RobSubstitution()
+{
+  CALL("RobSubstitution::~RobSubstitution");
+
+  for(size_t bi=0; bi<_banks.size(); bi++) {
+    if(_banks[bi]) {
+      delete _banks[bi];
+    }
+  }
+}
+
 /**
  * Unify @b t1 and @b t2, and return true iff it was successful.
  */
@@ -125,7 +136,7 @@ void RobSubstitution::denormalize(const Renaming& normalizer, int normalIndex, i
     Renaming::Item itm=nit.next();
     VarSpec normal(itm.second, normalIndex);
     VarSpec denormalized(itm.first, denormalizedIndex);
-    ASS(!_bank.find(denormalized));
+    ASS(!findBinding(denormalized));
     bindVar(denormalized,normal);
   }
 }
@@ -135,7 +146,7 @@ bool RobSubstitution::isUnbound(VarSpec v) const
   CALL("RobSubstitution::isUnbound");
   for(;;) {
     TermSpec binding;
-    bool found=_bank.find(v,binding);
+    bool found=findBinding(v,binding);
     if(!found || binding.index==UNBOUND_INDEX) {
       return true;
     } else if(binding.term.isTerm()) {
@@ -155,7 +166,7 @@ TermList RobSubstitution::getSpecialVarTop(unsigned specialVar) const
   VarSpec v(specialVar, SPECIAL_INDEX);
   for(;;) {
     TermSpec binding;
-    bool found=_bank.find(v,binding);
+    bool found=findBinding(v,binding);
     if(!found || binding.index==UNBOUND_INDEX) {
       static TermList auxVarTerm(1,false);
       return auxVarTerm;
@@ -180,7 +191,7 @@ RobSubstitution::TermSpec RobSubstitution::derefBound(TermSpec t) const
   VarSpec v=getVarSpec(t);
   for(;;) {
     TermSpec binding;
-    bool found=_bank.find(v,binding);
+    bool found=findBinding(v,binding);
     if(!found || binding.index==UNBOUND_INDEX) {
       return TermSpec(v);
     } else if(binding.term.isTerm()) {
@@ -195,7 +206,7 @@ RobSubstitution::TermSpec RobSubstitution::deref(VarSpec v) const
   CALL("RobSubstitution::deref");
   for(;;) {
     TermSpec binding;
-    bool found=_bank.find(v,binding);
+    bool found=findBinding(v,binding);
     if(!found) {
       binding.index=UNBOUND_INDEX;
       binding.term.makeVar(_nextUnboundAvailable++);
@@ -217,10 +228,101 @@ void RobSubstitution::bind(const VarSpec& v, const TermSpec& b)
   ASS(!b.term.isTerm() || b.index!=AUX_INDEX || b.term.term()->shared());
   ASS_NEQ(v.index, UNBOUND_INDEX);
 
-  if(bdIsRecording()) {
-    bdAdd(new BindingBacktrackObject(this, v));
+  if(_trailing) {
+    pushTrail(v);
+  } else if(bdIsRecording()) {
+    size_t mark=_trail.size();
+    pushTrail(v);
+    bdAdd(new TrailBacktrackObject(this, mark));
+  }
+  setBinding(v,b);
+}
+
+void RobSubstitution::setBinding(const VarSpec& v, const TermSpec& b) const
+{
+  CALL("RobSubstitution::setBinding");
+  ASS_GE(v.index,AUX_INDEX);
+
+  unsigned bi=v.index-AUX_INDEX;
+  if(bi>=_banks.size()) {
+    _banks.expand(bi+1, 0);
+  }
+  if(!_banks[bi]) {
+    _banks[bi]=new BankArray();
+  }
+  BankArray& bank=*_banks[bi];
+  if(v.var>=bank.size()) {
+    bank.expand(v.var+1);
+  }
+  Binding& binding=bank[v.var];
+  binding.term=b;
+  binding.gen=_gen;
+}
+
+void RobSubstitution::removeBinding(const VarSpec& v) const
+{
+  CALL("RobSubstitution::removeBinding");
+
+  unsigned bi=v.index-AUX_INDEX;
+  ASS_L(bi,_banks.size());
+  ASS_L(v.var,_banks[bi]->size());
+  (*_banks[bi])[v.var].gen=0;
+}
+
+/**
+ * Invalidate all bindings by moving to the next generation
+ */
+void RobSubstitution::nextGeneration()
+{
+  CALL("RobSubstitution::nextGeneration");
+
+  _gen++;
+  if(_gen!=0) {
+    return;
+  }
+  //the generation counter wrapped around, so we have to clear
+  //the bindings to not confuse the old ones with new ones
+  for(size_t bi=0; bi<_banks.size(); bi++) {
+    if(!_banks[bi]) {
+      continue;
+    }
+    BankArray& bank=*_banks[bi];
+    for(size_t i=0; i<bank.size(); i++) {
+      bank[i].gen=0;
+    }
+  }
+  _gen=1;
+}
+
+/**
+ * Save the current state of @b v to the undo trail
+ */
+void RobSubstitution::pushTrail(const VarSpec& v)
+{
+  CALL("RobSubstitution::pushTrail");
+
+  TrailEntry e(v);
+  if(!findBinding(v,e.old)) {
+    e.old.term.makeEmpty();
+  }
+  _trail.push(e);
+}
+
+/**
+ * Undo the bindings recorded on the trail after its length was @b mark
+ */
+void RobSubstitution::undoTrail(size_t mark)
+{
+  CALL("RobSubstitution::undoTrail");
+
+  while(_trail.size()>mark) {
+    TrailEntry e=_trail.pop();
+    if(e.old.term.isEmpty()) {
+      removeBinding(e.var);
+    } else {
+      setBinding(e.var,e.old);
+    }
   }
-  _bank.set(v,b);
 }
 
 void RobSubstitution::bindVar(const VarSpec& var, const VarSpec& to)
@@ -236,7 +338,7 @@ RobSubstitution::VarSpec RobSubstitution::root(VarSpec v) const
   CALL("RobSubstitution::root");
   for(;;) {
     TermSpec binding;
-    bool found=_bank.find(v,binding);
+    bool found=findBinding(v,binding);
     if(!found || binding.index==UNBOUND_INDEX || binding.term.isTerm()) {
       return v;
     }
@@ -292,14 +394,19 @@ void RobSubstitution::swap(TermSpec& ts1, TermSpec& ts2)
 
 bool RobSubstitution::occurs(VarSpec vs, TermSpec ts)
 {
-  vs=root(vs);
-  Stack<TermSpec> toDo(8);
   if(ts.isVar()) {
     ts=derefBound(ts);
     if(ts.isVar()) {
       return false;
     }
   }
+  if(ts.term.term()->shared() && ts.term.term()->ground()) {
+    return false;
+  }
+  vs=root(vs);
+
+  static Stack<TermSpec> toDo(8);
+  toDo.reset();
   typedef DHSet<VarSpec, VarSpec::Hash1> EncounterStore;
   static EncounterStore encountered;
   encountered.reset();
@@ -328,6 +435,41 @@ bool RobSubstitution::occurs(VarSpec vs, TermSpec ts)
   }
 }
 
+/**
+ * Start pushing all bindings to the trail and return the current trail
+ * length to be passed to @b endTrailing()
+ */
+size_t RobSubstitution::beginTrailing()
+{
+  CALL("RobSubstitution::beginTrailing");
+  ASS(!_trailing);
+
+  _trailing=true;
+  return _trail.size();
+}
+
+/**
+ * Finish a unification or matching that started with trail length @b mark.
+ * If it failed, undo its bindings. Otherwise keep the bindings and let them
+ * be backtracked, if backtracking data are being recorded.
+ */
+void RobSubstitution::endTrailing(size_t mark, bool failed)
+{
+  CALL("RobSubstitution::endTrailing");
+  ASS(_trailing);
+
+  _trailing=false;
+  if(failed) {
+    undoTrail(mark);
+  } else if(bdIsRecording()) {
+    if(_trail.size()>mark) {
+      bdAdd(new TrailBacktrackObject(this, mark));
+    }
+  } else {
+    _trail.truncate(mark);
+  }
+}
+
 bool RobSubstitution::unify(TermSpec t1, TermSpec t2)
 {
   CALL("RobSubstitution::unify/2");
@@ -337,15 +479,14 @@ bool RobSubstitution::unify(TermSpec t1, TermSpec t2)
   }
 
   bool mismatch=false;
-  BacktrackData localBD;
-  bdRecord(localBD);
+  size_t mark=beginTrailing();
 
   static Stack<TTPair> toDo(64);
   static Stack<TermList*> subterms(64);
   ASS(toDo.isEmpty() && subterms.isEmpty());
 
   typedef DHSet<TTPair,TTPairHash> EncStore;
-  EncStore encountered;
+  static EncStore encountered;
   encountered.reset();
 
   for(;;) {
@@ -431,16 +572,7 @@ bool RobSubstitution::unify(TermSpec t1, TermSpec t2)
     toDo.reset();
   }
 
-  bdDone();
-
-  if(mismatch) {
-    localBD.backtrack();
-  } else {
-    if(bdIsRecording()) {
-      bdCommit(localBD);
-    }
-    localBD.drop();
-  }
+  endTrailing(mark, mismatch);
 
   return !mismatch;
 }
@@ -463,8 +595,7 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
   }
 
   bool mismatch=false;
-  BacktrackData localBD;
-  bdRecord(localBD);
+  size_t mark=beginTrailing();
 
   static Stack<TermList*> subterms(64);
   ASS(subterms.isEmpty());
@@ -490,7 +621,7 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
       if (! TermList::sameTopFunctor(bts.term,its.term)) {
 	if(bts.term.isSpecialVar()) {
 	  VarSpec bvs(bts.term.var(), SPECIAL_INDEX);
-	  if(_bank.find(bvs, binding1)) {
+	  if(findBinding(bvs, binding1)) {
 	    ASS_EQ(binding1.index, base.index);
 	    bt=&binding1.term;
 	    continue;
@@ -499,7 +630,7 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
 	  }
 	} else if(its.term.isSpecialVar()) {
 	  VarSpec ivs(its.term.var(), SPECIAL_INDEX);
-	  if(_bank.find(ivs, binding2)) {
+	  if(findBinding(ivs, binding2)) {
 	    ASS_EQ(binding2.index, instance.index);
 	    it=&binding2.term;
 	    continue;
@@ -508,7 +639,7 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
 	  }
 	} else if(bts.term.isOrdinaryVar()) {
 	  VarSpec bvs(bts.term.var(), bts.index);
-	  if(_bank.find(bvs, binding1)) {
+	  if(findBinding(bvs, binding1)) {
 	    ASS_EQ(binding1.index, instance.index);
 	    if(!TermList::equals(binding1.term, its.term))
 	    {
@@ -536,19 +667,9 @@ bool RobSubstitution::match(TermSpec base, TermSpec instance)
     }
   }
 
-  bdDone();
-
   subterms.reset();
 
-
-  if(mismatch) {
-    localBD.backtrack();
-  } else {
-    if(bdIsRecording()) {
-      bdCommit(localBD);
-    }
-    localBD.drop();
-  }
+  endTrailing(mark, mismatch);
 
   return !mismatch;
 }
@@ -1006,11 +1127,13 @@ vstring RobSubstitution::toString(bool deref) const
 {
   CALL("RobSubstitution::toString");
   vstring res;
-  BankType::Iterator bit(_bank);
-  while(bit.hasNext()) {
-    VarSpec v;
+  for(size_t bi=0; bi<_banks.size(); bi++) {
+   for(unsigned var=0; _banks[bi] && var<_banks[bi]->size(); var++) {
+    VarSpec v(var, static_cast<int>(bi)+AUX_INDEX);
     TermSpec binding;
-    bit.next(v,binding);
+    if(!findBinding(v,binding)) {
+      continue;
+    }
     TermList tl;
     if(v.index==SPECIAL_INDEX) {
       res+="S"+Int::toString(v.var)+" -> ";
@@ -1025,7 +1148,22 @@ vstring RobSubstitution::toString(bool deref) const
     } else {
       res+=binding.term.toString()+"/"+Int::toString(binding.index)+"\n";
     }
+   }
+  }
+  return res;
+}
+
+size_t RobSubstitution::size() const
+{
+  CALL("RobSubstitution::size");
 
+  size_t res=0;
+  for(size_t bi=0; bi<_banks.size(); bi++) {
+    for(size_t var=0; _banks[bi] && var<_banks[bi]->size(); var++) {
+      if((*_banks[bi])[var].gen==_gen) {
+	res++;
+      }
+    }
   }
   return res;
 }
@@ -28,13 +28,16 @@
 #include <utility>
 
 #include "Forwards.hpp"
+#include "Lib/DArray.hpp"
 #include "Lib/DHMap.hpp"
 #include "Lib/Backtrackable.hpp"
+#include "Lib/Stack.hpp"
 #include "Term.hpp"
 
 #if VDEBUG
 
 #include <iostream>
+#include "Lib/Int.hpp"
 #include "Lib/VString.hpp"
 
 #endif
@@ -45,6 +48,15 @@ namespace Kernel
 using namespace std;
 using namespace Lib;
 
+/**
+ * Substitution built by the Robinson unification algorithm.
+ *
+ * Bindings are kept in arrays indexed by the variable bank and the
+ * variable number. Each binding carries the generation in which it was
+ * made, so @b reset() only starts a new generation. Bindings made while
+ * the substitution records backtracking data are pushed to an undo trail,
+ * and backtracking restores the trail back to a previously saved length.
+ */
 class RobSubstitution
 :public Backtrackable
 {
@@ -52,7 +64,8 @@ public:
   CLASS_NAME(RobSubstitution);
   USE_ALLOCATOR(RobSubstitution);
   
-  RobSubstitution() : _nextUnboundAvailable(0),_nextAuxAvailable(0) {}
+  RobSubstitution() : _gen(1), _trailing(false), _nextUnboundAvailable(0),_nextAuxAvailable(0) {}
+  ~RobSubstitution();
 
   SubstIterator matches(Literal* base, int baseIndex,
 	  Literal* instance, int instanceIndex, bool complementary);
@@ -75,7 +88,8 @@ public:
   }
   void reset()
   {
-    _bank.reset();
+    nextGeneration();
+    _trail.reset();
     _nextAuxAvailable=0;
     _nextUnboundAvailable=0;
   }
@@ -89,7 +103,7 @@ public:
   void bindSpecialVar(unsigned var, TermList t, int index)
   {
     VarSpec vs(var, SPECIAL_INDEX);
-    ASS(!_bank.find(vs));
+    ASS(!findBinding(vs));
     bind(vs, TermSpec(t,index));
   }
   TermList getSpecialVarTop(unsigned specialVar) const;
@@ -106,7 +120,7 @@ public:
    * - 0 means a fresh substitution.
    * - Without backtracking, this number doesn't decrease.
    */
-  size_t size() const {return _bank.size(); }
+  size_t size() const;
 #endif
 
 
@@ -231,6 +245,8 @@ private:
   VarSpec root(VarSpec v) const;
   bool match(TermSpec base, TermSpec instance);
   bool unify(TermSpec t1, TermSpec t2);
+  size_t beginTrailing();
+  void endTrailing(size_t mark, bool failed);
   bool handleDifferentTops(TermSpec t1, TermSpec t2, Stack<TTPair>& toDo, TermList* ct);
   void makeEqual(VarSpec v1, VarSpec v2, TermSpec target);
   void unifyUnbound(VarSpec v, TermSpec ts);
@@ -264,46 +280,105 @@ private:
   }
   static void swap(TermSpec& ts1, TermSpec& ts2);
 
-  typedef DHMap<VarSpec,TermSpec,VarSpec::Hash1, VarSpec::Hash2> BankType;
+  /** Binding of a variable, valid only if made in the current generation */
+  struct Binding
+  {
+    Binding() : gen(0) {}
+
+    TermSpec term;
+    /** Generation in which the binding was made, 0 if never */
+    unsigned gen;
+  };
+  typedef DArray<Binding> BankArray;
+
+  /** Previous state of a variable overwritten by a binding */
+  struct TrailEntry
+  {
+    TrailEntry() {}
+    TrailEntry(VarSpec var) : var(var) {}
+
+    VarSpec var;
+    /** Previous binding of @b var, or an empty term if it was unbound */
+    TermSpec old;
+  };
+
+  /**
+   * Return the array of bindings of the bank @b index, or zero if no
+   * variable of the bank has been bound yet
+   */
+  const BankArray* getBank(int index) const
+  {
+    ASS_GE(index,AUX_INDEX);
+    unsigned bi=index-AUX_INDEX;
+    return bi<_banks.size() ? _banks[bi] : 0;
+  }
+  /**
+   * If @b v is bound, assign its binding into @b res and return true,
+   * otherwise return false
+   */
+  bool findBinding(const VarSpec& v, TermSpec& res) const
+  {
+    const BankArray* bank=getBank(v.index);
+    if(!bank || v.var>=bank->size() || (*bank)[v.var].gen!=_gen) {
+      return false;
+    }
+    res=(*bank)[v.var].term;
+    return true;
+  }
+  bool findBinding(const VarSpec& v) const
+  {
+    TermSpec aux;
+    return findBinding(v, aux);
+  }
+  void setBinding(const VarSpec& v, const TermSpec& b) const;
+  void removeBinding(const VarSpec& v) const;
+  void nextGeneration();
+  void pushTrail(const VarSpec& v);
+  void undoTrail(size_t mark);
+
+  /**
+   * Binding arrays of the variable banks, the bank @b i is at @b i-AUX_INDEX
+   * (zero if no variable of the bank has been bound yet)
+   */
+  mutable DArray<BankArray*> _banks;
+  /** Current generation, bindings of other generations are not valid */
+  unsigned _gen;
 
-  mutable BankType _bank;
+  /** Undo trail of the bindings made while recording backtracking data */
+  Stack<TrailEntry> _trail;
+  /**
+   * True during unification and matching, when every binding is pushed
+   * to the trail and the whole operation is undone or committed at once
+   */
+  bool _trailing;
 
   DHMap<int, int> _denormIndexes;
 
   mutable unsigned _nextUnboundAvailable;
   unsigned _nextAuxAvailable;
 
-  class BindingBacktrackObject
+  /** Undoes the bindings on the trail above a saved trail length */
+  class TrailBacktrackObject
   : public BacktrackObject
   {
   public:
-    BindingBacktrackObject(RobSubstitution* subst, VarSpec v)
-    :_subst(subst), _var(v)
-    {
-      if(! _subst->_bank.find(_var,_term)) {
-	_term.term.makeEmpty();
-      }
-    }
+    TrailBacktrackObject(RobSubstitution* subst, size_t mark)
+    :_subst(subst), _mark(mark) {}
     void backtrack()
     {
-      if(_term.term.isEmpty()) {
-	_subst->_bank.remove(_var);
-      } else {
-	_subst->_bank.set(_var,_term);
-      }
+      _subst->undoTrail(_mark);
     }
 #if VDEBUG
     vstring toString() const
     {
-      return "(ROB backtrack object for "+ _var.toString() +")";
+      return "(ROB backtrack object to trail length "+ Int::toString(_mark) +")";
     }
 #endif
-    CLASS_NAME(RobSubstitution::BindingBacktrackObject);
-    USE_ALLOCATOR(BindingBacktrackObject);
+    CLASS_NAME(RobSubstitution::TrailBacktrackObject);
+    USE_ALLOCATOR(TrailBacktrackObject);
   private:
     RobSubstitution* _subst;
-    VarSpec _var;
-    TermSpec _term;
+    size_t _mark;
   };
 
   template<class Fn>
@@ -34,6 +34,7 @@
 #include "Inference.hpp"
 #include "InferenceStore.hpp"
 #include "Clause.hpp"
+#include "ClauseArena.hpp"
 #include "Formula.hpp"
 #include "FormulaUnit.hpp"
 #include "SubformulaIterator.hpp"
@@ -102,6 +103,7 @@ Unit::Unit(Kind kind,Inference* inf,InputType it)
   switch (inf->rule()) {
   case Inference::INPUT:
   case Inference::NEGATED_CONJECTURE:
+  case Inference::PROBLEM_CACHE:
     _adam = _number;
     break;
   default:
@@ -152,6 +154,7 @@ unsigned Unit::getPriority() const
   // Goal gets 1
   if(_inference->rule() == Inference::INPUT){ return 2; }
   if(_inference->rule() == Inference::NEGATED_CONJECTURE){ return 2; }
+  if(_inference->rule() == Inference::PROBLEM_CACHE){ return 2; }
 
   // If we get to here it means that the component did not have an orig
   if(_inference->rule() == Inference::AVATAR_COMPONENT){ return 2;} 
@@ -375,7 +378,10 @@ void Unit::assertValid()
   CALL("Unit::assertValid");
 
   if(isClause()) {
-    ASS_ALLOC_TYPE(this,"Clause");
+#if VDEBUG
+    Clause* cl = static_cast<Clause*>(this);
+    ClauseArena::assertValid(cl, cl->length());
+#endif
   }
   else {
     ASS_ALLOC_TYPE(this,"FormulaUnit");
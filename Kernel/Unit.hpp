@@ -169,6 +169,12 @@ public:
   static void onPreprocessingEnd();
   static void onParsingEnd(){ _lastParsingNumber = _lastNumber;}
   static unsigned getLastParsingNumber(){ return _lastParsingNumber;}
+  static unsigned getLastNumber(){ return _lastNumber;}
+  /**
+   * Make the next created unit have the number @b number+1. Used when
+   * restoring units with their original numbers from the problem cache.
+   */
+  static void setLastNumber(unsigned number){ _lastNumber = number;}
 
 protected:
   /** Number of this unit, used for printing and statistics */
@@ -25,6 +25,7 @@
 
 #include "Debug/Tracer.hpp"
 
+#include "Lib/Sys/ProgressChannel.hpp"
 #include "Lib/Sys/SyncPipe.hpp"
 
 #include "Indexing/TermSharing.hpp"
@@ -106,7 +107,7 @@ bool Environment::timeLimitReached() const
   CALL("Environment::timeLimitReached");
 
   if (options->timeLimitInDeciseconds() &&
-      timer->elapsedDeciseconds() > options->timeLimitInDeciseconds()) {
+      timer->elapsedDeciseconds() > options->timeLimitInDeciseconds()+Sys::ProgressChannel::extraTime()) {
     statistics->terminationReason = Shell::Statistics::TIME_LIMIT;
     return true;
   }
@@ -119,7 +120,7 @@ bool Environment::timeLimitReached() const
  */
 int Environment::remainingTime() const
 {
-  return options->timeLimitInDeciseconds()*100 - timer->elapsedMilliseconds();
+  return (options->timeLimitInDeciseconds()+Sys::ProgressChannel::extraTime())*100 - timer->elapsedMilliseconds();
 }
 
 /**
@@ -179,19 +179,27 @@ public:
   {
     CALL("Set::insert");
 
+    return insertWithHash(val,Hash::hash(val));
+  } // Set::insert
+
+  /**
+   * Same as insert(Val), for callers that already know
+   * the hash code @b code of @b val.
+   */
+  inline Val insertWithHash(const Val val,unsigned code)
+  {
+    CALL("Set::insertWithHash");
+
     if (_nonemptyCells >= _maxEntries) { // too many entries
       expand();
     }
 
-    unsigned code;
-    code = Hash::hash(val);
-
     if (code < 2) {
       code = 2;
     }
 
     return insert(val,code);
-  } // Set::insert
+  } // Set::insertWithHash
 
   /**
    * Insert a value with a given code in the set.
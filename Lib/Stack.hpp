@@ -343,6 +343,11 @@ public:
   size_t size() const
   { return _cursor - _stack; }
 
+  /** Return the number of elements the stack can hold before it has to expand */
+  inline
+  size_t capacity() const
+  { return _capacity; }
+
   bool find(const C& el) const
   {
     CALL("Stack::find");
@@ -0,0 +1,80 @@
+/**
+ * @file MappedFile.cpp
+ * Implements class MappedFile.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Debug/Tracer.hpp"
+
+#include "MappedFile.hpp"
+
+namespace Lib
+{
+namespace Sys
+{
+
+MappedFile::MappedFile(const vstring& fileName)
+: _open(false), _data(0), _size(0)
+{
+  CALL("MappedFile::MappedFile");
+
+  int fd=open(fileName.c_str(), O_RDONLY);
+  if(fd==-1) {
+    return;
+  }
+  struct stat st;
+  if(fstat(fd, &st)==-1 || !S_ISREG(st.st_mode)) {
+    close(fd);
+    return;
+  }
+  _size=st.st_size;
+  if(_size==0) {
+    //an empty file cannot be mapped, but there is nothing to read anyway
+    close(fd);
+    _open=true;
+    return;
+  }
+  void* mem=mmap(0, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+  //the mapping stays valid after the descriptor is closed
+  close(fd);
+  if(mem==MAP_FAILED) {
+    _size=0;
+    return;
+  }
+  madvise(mem, _size, MADV_SEQUENTIAL);
+  _data=static_cast<const char*>(mem);
+  _open=true;
+}
+
+MappedFile::~MappedFile()
+{
+  CALL("MappedFile::~MappedFile");
+
+  if(_data) {
+    munmap(const_cast<char*>(_data), _size);
+  }
+}
+
+/**
+ * Ask the system to start reading the file @b fileName into the page cache
+ * in the background, so that it is in memory by the time it is mapped.
+ * Errors are ignored, they will be reported when the file is opened.
+ */
+void MappedFile::prefetch(const vstring& fileName)
+{
+  CALL("MappedFile::prefetch");
+
+  int fd=open(fileName.c_str(), O_RDONLY);
+  if(fd==-1) {
+    return;
+  }
+  posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+  close(fd);
+}
+
+}
+}
@@ -0,0 +1,55 @@
+/**
+ * @file MappedFile.hpp
+ * Defines class MappedFile.
+ */
+
+#ifndef __MappedFile__
+#define __MappedFile__
+
+#include <cstddef>
+
+#include "Forwards.hpp"
+
+#include "Lib/Allocator.hpp"
+#include "Lib/VString.hpp"
+
+namespace Lib {
+namespace Sys {
+
+/**
+ * A regular file mapped read-only into memory
+ *
+ * If the file cannot be mapped (it does not exist, is not a regular file
+ * or the system refuses the mapping), the object is not open and the caller
+ * can fall back to reading the file through a stream.
+ */
+class MappedFile {
+public:
+  CLASS_NAME(MappedFile);
+  USE_ALLOCATOR(MappedFile);
+
+  MappedFile(const vstring& fileName);
+  ~MappedFile();
+
+  /** Return true iff the file has been mapped */
+  bool isOpen() const { return _open; }
+  /** Return the first byte of the file, or 0 if the file is empty */
+  const char* data() const { return _data; }
+  /** Return the length of the file in bytes */
+  size_t size() const { return _size; }
+
+  static void prefetch(const vstring& fileName);
+
+private:
+  MappedFile(const MappedFile&); //private and undefined
+  const MappedFile& operator=(const MappedFile&); //private and undefined
+
+  bool _open;
+  const char* _data;
+  size_t _size;
+};
+
+}
+}
+
+#endif // __MappedFile__
@@ -230,12 +230,22 @@ void Multiprocessing::killNoCheck(pid_t child, int signal)
   ::kill(child, signal);
 }
 
-pid_t Multiprocessing::poll_children(bool &stopped, bool &exited, int &code)
+/**
+ * Wait until a child stops or exits and return its pid.
+ *
+ * If @b wait is false and no child has changed its state, return 0
+ * immediately.
+ */
+pid_t Multiprocessing::poll_children(bool &stopped, bool &exited, int &code, bool wait)
 {
   CALL("Multiprocessing::poll_child");
 
   int status;
-  pid_t pid = waitpid(-1, &status, WUNTRACED);
+  pid_t pid = waitpid(-1, &status, wait ? WUNTRACED : (WUNTRACED | WNOHANG));
+  if(pid <= 0) {
+    stopped = exited = false;
+    return 0;
+  }
   stopped = WIFSTOPPED(status);
   exited = WIFEXITED(status);
   if(exited)
@@ -0,0 +1,100 @@
+/**
+ * @file ProgressChannel.cpp
+ * Implements class ProgressChannel.
+ */
+
+#include <cerrno>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "Lib/Allocator.hpp"
+#include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
+
+#include "Shell/Statistics.hpp"
+
+#include "ProgressChannel.hpp"
+
+namespace Lib
+{
+namespace Sys
+{
+
+ProgressRecord* ProgressChannel::s_published = 0;
+
+/**
+ * Create a channel with @b size zero-initialized records
+ */
+ProgressChannel::ProgressChannel(unsigned size)
+: _size(size)
+{
+  CALL("ProgressChannel::ProgressChannel");
+
+  size_t bytes = (size ? size : 1)*sizeof(ProgressRecord);
+  void* mem = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if(mem==MAP_FAILED) {
+    SYSTEM_FAIL("Call to mmap() failed when creating progress channel.",errno);
+  }
+  //anonymous mappings are zero-filled
+  _records = static_cast<ProgressRecord*>(mem);
+}
+
+ProgressChannel::~ProgressChannel()
+{
+  CALL("ProgressChannel::~ProgressChannel");
+
+  if(s_published>=_records && s_published<_records+_size) {
+    s_published = 0;
+  }
+  munmap(_records, (_size ? _size : 1)*sizeof(ProgressRecord));
+}
+
+ProgressRecord& ProgressChannel::operator[](unsigned i)
+{
+  CALL("ProgressChannel::operator[]");
+  ASS_L(i,_size);
+
+  return _records[i];
+}
+
+/**
+ * Make @b publish() in the current process update the record @b rec
+ * (or nothing if @b rec is zero)
+ */
+void ProgressChannel::setPublishingSlot(ProgressRecord* rec)
+{
+  CALL("ProgressChannel::setPublishingSlot");
+
+  s_published = rec;
+  if(rec) {
+    rec->pid = getpid();
+  }
+}
+
+/**
+ * Copy the current progress counters of this process into its record,
+ * if it has one
+ */
+void ProgressChannel::publish()
+{
+  if(!s_published) {
+    return;
+  }
+  s_published->phase = env.statistics->phase;
+  s_published->activeClauses = env.statistics->activeClauses;
+  s_published->passiveClauses = env.statistics->passiveClauses;
+  s_published->generatedClauses = env.statistics->generatedClauses;
+  s_published->memory = Allocator::getUsedMemory();
+}
+
+/**
+ * Return the number of deciseconds the parent added to the time limit of
+ * the current process (zero if the process has no record)
+ */
+int ProgressChannel::extraTime()
+{
+  return s_published ? s_published->extraTime : 0;
+}
+
+}
+}
@@ -0,0 +1,70 @@
+/**
+ * @file ProgressChannel.hpp
+ * Defines class ProgressChannel.
+ */
+
+#ifndef __ProgressChannel__
+#define __ProgressChannel__
+
+#include <sys/types.h>
+
+#include "Forwards.hpp"
+
+namespace Lib {
+namespace Sys {
+
+/**
+ * Progress of a child process as last published by the child.
+ *
+ * Records live in memory shared between the parent and its children.
+ * Every field except @b extraTime is written by the child only and read
+ * by the parent.
+ */
+struct ProgressRecord
+{
+  /** Pid of the publishing process, or 0 if nothing was published yet */
+  volatile pid_t pid;
+  /** Execution phase of the publishing process (a Shell::Statistics::ExecutionPhase value) */
+  volatile int phase;
+  volatile unsigned activeClauses;
+  volatile unsigned passiveClauses;
+  volatile unsigned generatedClauses;
+  /** Memory allocated by the publishing process in bytes */
+  volatile size_t memory;
+  /** Deciseconds the parent added to the time limit of the process */
+  volatile int extraTime;
+};
+
+/**
+ * A fixed number of ProgressRecord slots in anonymous shared memory.
+ *
+ * The parent creates the channel before forking. A child selects its slot
+ * by @b setPublishingSlot() and then updates it by @b publish().
+ */
+class ProgressChannel {
+public:
+  explicit ProgressChannel(unsigned size);
+  ~ProgressChannel();
+
+  unsigned size() const { return _size; }
+  ProgressRecord& operator[](unsigned i);
+
+  static void setPublishingSlot(ProgressRecord* rec);
+  static void publish();
+  static int extraTime();
+
+private:
+  ProgressChannel(const ProgressChannel&);
+  ProgressChannel& operator=(const ProgressChannel&);
+
+  unsigned _size;
+  ProgressRecord* _records;
+
+  /** Record updated by @b publish() in the current process, or 0 */
+  static ProgressRecord* s_published;
+};
+
+}
+}
+
+#endif // __ProgressChannel__
@@ -248,6 +248,42 @@ void Lib::Timer::makeChildrenIncluded()
   //here are children always included as we measure the wall clock time
 }
 
+/**
+ * Make SIGTSTP stop the current process the way SIGSTOP does, except that
+ * the wall clock time until the process is continued does not count as
+ * elapsed. Used by processes that the parent may suspend and resume later.
+ */
+void Lib::Timer::pauseWhileStopped()
+{
+  signal(SIGTSTP, sigtstpHandler);
+}
+
+void Lib::Timer::sigtstpHandler(int sig)
+{
+  int savedErrno=errno;
+
+  //no SIGALRM ticks while we are stopped
+  itimerval off, old;
+  off.it_value.tv_usec=0;
+  off.it_value.tv_sec=0;
+  off.it_interval.tv_usec=0;
+  off.it_interval.tv_sec=0;
+  setitimer(ITIMER_REAL, &off, &old);
+  int stoppedAt=guaranteedMilliseconds();
+
+  raise(SIGSTOP);
+  //here we were continued by SIGCONT
+
+  //shift the base of syncClock() so that it does not add the time spent stopped
+  int resumedAt=guaranteedMilliseconds();
+  if(stoppedAt!=-1 && resumedAt!=-1 && s_initGuarantedMiliseconds!=-1) {
+    s_initGuarantedMiliseconds+=resumedAt-stoppedAt;
+  }
+  setitimer(ITIMER_REAL, &old, 0);
+
+  errno=savedErrno;
+}
+
 #else
 
 #include <sys/time.h>
@@ -279,6 +315,13 @@ void Lib::Timer::syncClock()
 {
 }
 
+/**
+ * The CPU time does not advance while the process is stopped
+ */
+void Lib::Timer::pauseWhileStopped()
+{
+}
+
 void Lib::Timer::ensureTimerInitialized()
 {
 }
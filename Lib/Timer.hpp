@@ -128,6 +128,7 @@ public:
   { s_timeLimitEnforcement = enabled; }
 
   static void syncClock();
+  static void pauseWhileStopped();
 
   static bool s_timeLimitEnforcement;
 private:
@@ -148,6 +149,7 @@ private:
   static void restoreTimerAfterFork();
 
   static int guaranteedMilliseconds();
+  static void sigtstpHandler(int sig);
 
   static long s_ticksPerSec;
   static int s_initGuarantedMiliseconds;
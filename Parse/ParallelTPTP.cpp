@@ -0,0 +1,785 @@
+/*
+ * File ParallelTPTP.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file Parse/ParallelTPTP.cpp
+ * Implements class ParallelTPTP.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/ScopedPtr.hpp"
+#include "Lib/System.hpp"
+#include "Lib/Sys/MappedFile.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Formula.hpp"
+#include "Kernel/FormulaUnit.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Signature.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+
+#include "Shell/Options.hpp"
+#include "Shell/Statistics.hpp"
+
+#include "TPTP.hpp"
+
+#include "ParallelTPTP.hpp"
+
+namespace Parse
+{
+
+using namespace Lib::Sys;
+using namespace Shell;
+
+/**
+ * The result file of one worker being read by the parent, together with
+ * the numbers the symbols added by the worker have in the parent
+ */
+class ParallelTPTP::Input
+{
+public:
+  Input() : firstFunction(0), firstPredicate(0), failed(true), _pos(0), _end(0) {}
+
+  /** Map the result file @b fileName, return false if it cannot be read */
+  bool open(const vstring& fileName)
+  {
+    _file=new MappedFile(fileName);
+    if(!_file->isOpen()) {
+      return false;
+    }
+    _pos=_file->data();
+    _end=_pos+_file->size();
+    firstFunction=env.signature->functions();
+    firstPredicate=env.signature->predicates();
+    return true;
+  }
+
+  bool atEnd() const { return _pos==_end; }
+
+  unsigned readWord()
+  {
+    ASS_LE(sizeof(unsigned), static_cast<size_t>(_end-_pos));
+    unsigned res;
+    memcpy(&res, _pos, sizeof(unsigned));
+    _pos+=sizeof(unsigned);
+    return res;
+  }
+
+  vstring readString()
+  {
+    unsigned len=readWord();
+    ASS_LE(len, static_cast<size_t>(_end-_pos));
+    vstring res(_pos, len);
+    _pos+=len;
+    return res;
+  }
+
+  /** Return the number in the signature of the worker's function @b num */
+  unsigned function(unsigned num) const
+  {
+    return num<firstFunction ? num : functions[num-firstFunction];
+  }
+
+  /** Return the number in the signature of the worker's predicate @b num */
+  unsigned predicate(unsigned num) const
+  {
+    return num<firstPredicate ? num : predicates[num-firstPredicate];
+  }
+
+  /** Numbers of the functions added by the worker, in the order it added them */
+  Stack<unsigned> functions;
+  /** Numbers of the predicates added by the worker, in the order it added them */
+  Stack<unsigned> predicates;
+  unsigned firstFunction;
+  unsigned firstPredicate;
+  /** True if the remaining files of the worker are to be parsed by the parent */
+  bool failed;
+
+private:
+  ScopedPtr<MappedFile> _file;
+  const char* _pos;
+  const char* _end;
+};
+
+ParallelTPTP::ParallelTPTP(const Stack<vstring>& fileNames)
+: _fileNames(fileNames), _units(fileNames.size()), _conjectures(fileNames.size()), _workerCnt(0)
+{
+  CALL("ParallelTPTP::ParallelTPTP");
+
+  _units.init(fileNames.size(), 0);
+  _conjectures.init(fileNames.size(), false);
+}
+
+ParallelTPTP::~ParallelTPTP()
+{
+  CALL("ParallelTPTP::~ParallelTPTP");
+
+  removeResults();
+}
+
+/**
+ * Return the number of workers given by the cores option, where 0 stands
+ * for all available cores
+ */
+unsigned ParallelTPTP::getNumWorkers()
+{
+  CALL("ParallelTPTP::getNumWorkers");
+
+  unsigned cores = System::getNumberOfCores();
+  cores = cores < 1 ? 1 : cores;
+  unsigned workers = env.options->multicore();
+  if(!workers || workers>cores) {
+    workers = cores;
+  }
+  return workers;
+}
+
+/**
+ * Parse all the files
+ */
+void ParallelTPTP::parse()
+{
+  CALL("ParallelTPTP::parse");
+
+  unsigned fileCnt=_fileNames.size();
+  _workerCnt=getNumWorkers();
+  if(_workerCnt>fileCnt) {
+    _workerCnt=fileCnt;
+  }
+  char dirName[]="/tmp/vampire_inc_XXXXXX";
+  if(_workerCnt<2 || !mkdtemp(dirName)) {
+    for(unsigned i=0;i<fileCnt;i++) {
+      parseHere(i);
+    }
+    return;
+  }
+  _resultDir=dirName;
+
+  //each worker reads its later files from the disk while parsing the first ones
+  for(unsigned i=0;i<fileCnt;i++) {
+    MappedFile::prefetch(_fileNames[i]);
+  }
+
+  DArray<pid_t> workers(_workerCnt);
+  for(unsigned w=0;w<_workerCnt;w++) {
+    pid_t pid=Multiprocessing::instance()->fork();
+    ASS_NEQ(pid, -1);
+    if(!pid) {
+      runWorker(w);
+    }
+    workers[w]=pid;
+  }
+
+  DArray<Input> inputs(_workerCnt);
+  for(unsigned i=0;i<_workerCnt;i++) {
+    int exitCode;
+    pid_t pid=Multiprocessing::instance()->waitForChildTermination(exitCode);
+    for(unsigned w=0;w<_workerCnt;w++) {
+      if(workers[w]==pid) {
+	//the results of a worker that failed are not used at all
+	inputs[w].failed=exitCode!=0;
+	break;
+      }
+    }
+  }
+  for(unsigned w=0;w<_workerCnt;w++) {
+    if(!inputs[w].failed) {
+      inputs[w].failed=!inputs[w].open(getResultName(w));
+    }
+  }
+  //the mapped files stay readable after they are removed
+  removeResults();
+
+  for(unsigned i=0;i<fileCnt;i++) {
+    Input& in=inputs[i%_workerCnt];
+    //a worker stops at the first file it cannot pass to the parent
+    if(in.failed || in.atEnd()) {
+      in.failed=true;
+      parseHere(i);
+      continue;
+    }
+    readFile(in, i);
+  }
+}
+
+/**
+ * Parse the file number @b fileIndex in this process
+ */
+void ParallelTPTP::parseHere(unsigned fileIndex)
+{
+  CALL("ParallelTPTP::parseHere");
+
+  TPTP parser(_fileNames[fileIndex]);
+  parser.parse();
+  _units[fileIndex]=parser.units();
+  _conjectures[fileIndex]=parser.containsConjecture();
+}
+
+/**
+ * Parse the files of the worker @b worker and write the results, then
+ * terminate the process
+ *
+ * For each file, the result file holds the change of the input statistics,
+ * the names and arities of the added symbols and the units. Terms are
+ * written in prefix order as variable numbers with VAR_FLAG and function
+ * numbers of the worker's signature.
+ */
+void ParallelTPTP::runWorker(unsigned worker)
+{
+  CALL("ParallelTPTP::runWorker");
+
+  vstring out;
+  unsigned sortCnt=env.sorts->count();
+  bool colorUsed=env.colorUsed;
+  unsigned functions=env.signature->functions();
+  unsigned predicates=env.signature->predicates();
+  try {
+    for(unsigned i=worker;i<_fileNames.size();i+=_workerCnt) {
+      unsigned inputFormulas=env.statistics->inputFormulas;
+      unsigned inputClauses=env.statistics->inputClauses;
+      unsigned firstNumber=Unit::getLastNumber();
+
+      TPTP parser(_fileNames[i]);
+      parser.parse();
+      UnitList* units=parser.units();
+      if(parser.containsConjecture() || parser.containsDeclarations() ||
+	 env.sorts->count()!=sortCnt || env.colorUsed!=colorUsed ||
+	 !canWriteSymbols(functions, predicates)) {
+	break;
+      }
+      UnitList::Iterator uit(units);
+      bool canWrite=true;
+      while(canWrite && uit.hasNext()) {
+	canWrite=canWriteUnit(uit.next());
+      }
+      if(!canWrite) {
+	break;
+      }
+
+      writeWord(out, env.statistics->inputFormulas-inputFormulas);
+      writeWord(out, env.statistics->inputClauses-inputClauses);
+      writeWord(out, env.signature->functions()-functions);
+      for(;functions<env.signature->functions();functions++) {
+	writeString(out, getSymbolKey(env.signature->functionName(functions)));
+	writeWord(out, env.signature->functionArity(functions));
+      }
+      writeWord(out, env.signature->predicates()-predicates);
+      for(;predicates<env.signature->predicates();predicates++) {
+	writeString(out, getSymbolKey(env.signature->predicateName(predicates)));
+	writeWord(out, env.signature->predicateArity(predicates));
+      }
+      writeWord(out, Unit::getLastNumber()-firstNumber);
+      writeWord(out, UnitList::length(units));
+      uit.reset(units);
+      while(uit.hasNext()) {
+	writeUnit(out, uit.next(), firstNumber);
+      }
+    }
+  }
+  catch(...) {
+    //the parent parses the file again and reports the error
+  }
+
+  FILE* f=fopen(getResultName(worker).c_str(), "wb");
+  bool ok=f && fwrite(out.data(), 1, out.size(), f)==out.size();
+  ok=f && fclose(f)==0 && ok;
+  System::terminateImmediately(ok ? 0 : 1);
+}
+
+vstring ParallelTPTP::getResultName(unsigned worker) const
+{
+  return _resultDir+"/"+Int::toString(worker);
+}
+
+/**
+ * Remove the result files of the workers and their directory
+ */
+void ParallelTPTP::removeResults()
+{
+  CALL("ParallelTPTP::removeResults");
+
+  if(_resultDir.empty()) {
+    return;
+  }
+  for(unsigned w=0;w<_workerCnt;w++) {
+    remove(getResultName(w).c_str());
+  }
+  rmdir(_resultDir.c_str());
+  _resultDir="";
+}
+
+/**
+ * Return true if the symbols added to the signature after the first
+ * @b firstFunction functions and @b firstPredicate predicates are
+ * uninterpreted symbols of the default sort without any special properties
+ */
+bool ParallelTPTP::canWriteSymbols(unsigned firstFunction, unsigned firstPredicate)
+{
+  CALL("ParallelTPTP::canWriteSymbols");
+
+  for(unsigned i=firstFunction;i<env.signature->functions();i++) {
+    Signature::Symbol* sym=env.signature->getFunction(i);
+    if(sym->interpreted() || sym->stringConstant() || sym->numericConstant() ||
+       sym->overflownConstant() || sym->termAlgebraCons() || sym->skip() ||
+       sym->color()!=COLOR_TRANSPARENT || !sym->fnType()->isAllDefault()) {
+      return false;
+    }
+  }
+  for(unsigned i=firstPredicate;i<env.signature->predicates();i++) {
+    Signature::Symbol* sym=env.signature->getPredicate(i);
+    if(sym->interpreted() || sym->answerPredicate() || sym->label() || sym->skip() ||
+       sym->color()!=COLOR_TRANSPARENT || !sym->predType()->isAllDefault()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Return true if @b u is an input unit the parent can rebuild
+ */
+bool ParallelTPTP::canWriteUnit(Unit* u)
+{
+  CALL("ParallelTPTP::canWriteUnit");
+
+  if(u->inference()->rule()!=Inference::INPUT || u->inheritedColor()!=COLOR_TRANSPARENT) {
+    return false;
+  }
+  if(!u->isClause()) {
+    return canWriteFormula(static_cast<FormulaUnit*>(u)->formula());
+  }
+  Clause* cl=u->asClause();
+  for(unsigned i=0;i<cl->length();i++) {
+    if(!canWriteLiteral((*cl)[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParallelTPTP::canWriteFormula(Formula* f)
+{
+  CALL("ParallelTPTP::canWriteFormula");
+
+  switch(f->connective()) {
+  case LITERAL:
+    return canWriteLiteral(f->literal());
+  case AND:
+  case OR:
+    {
+      FormulaList::Iterator fit(f->args());
+      while(fit.hasNext()) {
+	if(!canWriteFormula(fit.next())) {
+	  return false;
+	}
+      }
+      return true;
+    }
+  case IMP:
+  case IFF:
+  case XOR:
+    return canWriteFormula(f->left()) && canWriteFormula(f->right());
+  case NOT:
+    return canWriteFormula(f->uarg());
+  case FORALL:
+  case EXISTS:
+    return canWriteFormula(f->qarg());
+  case TRUE:
+  case FALSE:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/**
+ * Return true if @b lit is a shared literal without special terms
+ */
+bool ParallelTPTP::canWriteLiteral(Literal* lit)
+{
+  CALL("ParallelTPTP::canWriteLiteral");
+
+  if(!lit->shared()) {
+    return false;
+  }
+  static Stack<const TermList*> toDo;
+  toDo.reset();
+  toDo.push(lit->args());
+  while(toDo.isNonEmpty()) {
+    const TermList* ts=toDo.pop();
+    if(ts->isEmpty()) {
+      continue;
+    }
+    toDo.push(ts->next());
+    if(ts->isSpecialVar() || (ts->isTerm() && ts->term()->isSpecial())) {
+      return false;
+    }
+    if(ts->isTerm()) {
+      toDo.push(ts->term()->args());
+    }
+  }
+  return true;
+}
+
+/**
+ * Return the name under which the symbol printed as @b name is added
+ * to the signature
+ *
+ * The signature quotes the names that need it when the symbol is created,
+ * and a name that starts with a quote always needs it.
+ */
+vstring ParallelTPTP::getSymbolKey(const vstring& name)
+{
+  if(name.size()>1 && name[0]=='\'') {
+    return name.substr(1, name.size()-2);
+  }
+  return name;
+}
+
+void ParallelTPTP::writeWord(vstring& out, unsigned w)
+{
+  out.append(reinterpret_cast<const char*>(&w), sizeof(unsigned));
+}
+
+void ParallelTPTP::writeString(vstring& out, const vstring& str)
+{
+  writeWord(out, str.size());
+  out.append(str);
+}
+
+/**
+ * Write the unit @b u, whose number is given relative to @b firstNumber
+ */
+void ParallelTPTP::writeUnit(vstring& out, Unit* u, unsigned firstNumber)
+{
+  CALL("ParallelTPTP::writeUnit");
+
+  writeWord(out, u->number()-firstNumber);
+  writeWord(out, u->isClause());
+  writeWord(out, u->inputType());
+  writeWord(out, u->included());
+  vstring name;
+  bool named=TPTP::findAxiomName(u, name);
+  writeWord(out, named);
+  if(named) {
+    writeString(out, name);
+  }
+  if(!u->isClause()) {
+    writeFormula(out, static_cast<FormulaUnit*>(u)->formula());
+    return;
+  }
+  Clause* cl=u->asClause();
+  writeWord(out, cl->length());
+  for(unsigned i=0;i<cl->length();i++) {
+    writeLiteral(out, (*cl)[i]);
+  }
+}
+
+void ParallelTPTP::writeFormula(vstring& out, Formula* f)
+{
+  CALL("ParallelTPTP::writeFormula");
+
+  writeWord(out, f->connective());
+  switch(f->connective()) {
+  case LITERAL:
+    writeLiteral(out, f->literal());
+    break;
+  case AND:
+  case OR:
+    {
+      writeWord(out, FormulaList::length(f->args()));
+      FormulaList::Iterator fit(f->args());
+      while(fit.hasNext()) {
+	writeFormula(out, fit.next());
+      }
+    }
+    break;
+  case IMP:
+  case IFF:
+  case XOR:
+    writeFormula(out, f->left());
+    writeFormula(out, f->right());
+    break;
+  case NOT:
+    writeFormula(out, f->uarg());
+    break;
+  case FORALL:
+  case EXISTS:
+    {
+      writeWord(out, Formula::VarList::length(f->vars()));
+      Formula::VarList::Iterator vit(f->vars());
+      while(vit.hasNext()) {
+	writeWord(out, vit.next());
+      }
+      writeWord(out, Formula::SortList::length(f->sorts()));
+      Formula::SortList::Iterator sit(f->sorts());
+      while(sit.hasNext()) {
+	writeWord(out, sit.next());
+      }
+      writeFormula(out, f->qarg());
+    }
+    break;
+  case TRUE:
+  case FALSE:
+    break;
+  default:
+    ASSERTION_VIOLATION;
+  }
+}
+
+void ParallelTPTP::writeLiteral(vstring& out, Literal* lit)
+{
+  CALL("ParallelTPTP::writeLiteral");
+
+  writeWord(out, lit->functor());
+  writeWord(out, lit->polarity());
+  if(lit->isEquality()) {
+    writeWord(out, SortHelper::getEqualityArgumentSort(lit));
+  }
+  static Stack<const TermList*> toDo;
+  toDo.reset();
+  toDo.push(lit->args());
+  while(toDo.isNonEmpty()) {
+    const TermList* ts=toDo.pop();
+    if(ts->isEmpty()) {
+      continue;
+    }
+    toDo.push(ts->next());
+    if(ts->isVar()) {
+      ASS_L(ts->var(), VAR_FLAG);
+      writeWord(out, ts->var() | VAR_FLAG);
+    }
+    else {
+      writeWord(out, ts->term()->functor());
+      toDo.push(ts->term()->args());
+    }
+  }
+}
+
+/**
+ * Add the results of the file number @b fileIndex from the worker's result
+ * file @b in to the signature and to the units of the file
+ */
+void ParallelTPTP::readFile(Input& in, unsigned fileIndex)
+{
+  CALL("ParallelTPTP::readFile");
+
+  env.statistics->inputFormulas+=in.readWord();
+  env.statistics->inputClauses+=in.readWord();
+
+  //symbols added by earlier files are found in the signature
+  unsigned cnt=in.readWord();
+  for(unsigned i=0;i<cnt;i++) {
+    vstring name=in.readString();
+    unsigned arity=in.readWord();
+    in.functions.push(env.signature->addFunction(name, arity));
+  }
+  cnt=in.readWord();
+  for(unsigned i=0;i<cnt;i++) {
+    vstring name=in.readString();
+    unsigned arity=in.readWord();
+    in.predicates.push(env.signature->addPredicate(name, arity));
+  }
+
+  //units get the numbers they would get when parsed here
+  unsigned firstNumber=Unit::getLastNumber();
+  unsigned numbersUsed=in.readWord();
+  UnitList* units=0;
+  UnitList** tail=&units;
+  cnt=in.readWord();
+  for(unsigned i=0;i<cnt;i++) {
+    *tail=new UnitList(readUnit(in, firstNumber), 0);
+    tail=(*tail)->tailPtr();
+  }
+  Unit::setLastNumber(firstNumber+numbersUsed);
+  _units[fileIndex]=units;
+}
+
+Unit* ParallelTPTP::readUnit(Input& in, unsigned firstNumber)
+{
+  CALL("ParallelTPTP::readUnit");
+
+  Unit::setLastNumber(firstNumber+in.readWord()-1);
+  bool isClause=in.readWord();
+  Unit::InputType inputType=static_cast<Unit::InputType>(in.readWord());
+  bool included=in.readWord();
+  vstring name;
+  bool named=in.readWord();
+  if(named) {
+    name=in.readString();
+  }
+
+  Unit* res;
+  if(isClause) {
+    static Stack<Literal*> lits;
+    lits.reset();
+    unsigned len=in.readWord();
+    for(unsigned i=0;i<len;i++) {
+      lits.push(readLiteral(in));
+    }
+    res=Clause::fromStack(lits, inputType, new Inference(Inference::INPUT));
+  }
+  else {
+    Formula* f=readFormula(in);
+    res=new FormulaUnit(f, new Inference(Inference::INPUT), inputType);
+  }
+  res->setInheritedColor(COLOR_TRANSPARENT);
+  if(named) {
+    TPTP::assignAxiomName(res, name);
+  }
+  if(included) {
+    res->markIncluded();
+  }
+  return res;
+}
+
+Formula* ParallelTPTP::readFormula(Input& in)
+{
+  CALL("ParallelTPTP::readFormula");
+
+  Connective con=static_cast<Connective>(in.readWord());
+  switch(con) {
+  case LITERAL:
+    return new AtomicFormula(readLiteral(in));
+  case AND:
+  case OR:
+    {
+      FormulaList* args=0;
+      FormulaList** tail=&args;
+      unsigned cnt=in.readWord();
+      for(unsigned i=0;i<cnt;i++) {
+	*tail=new FormulaList(readFormula(in), 0);
+	tail=(*tail)->tailPtr();
+      }
+      return new JunctionFormula(con, args);
+    }
+  case IMP:
+  case IFF:
+  case XOR:
+    {
+      Formula* left=readFormula(in);
+      Formula* right=readFormula(in);
+      return new BinaryFormula(con, left, right);
+    }
+  case NOT:
+    return new NegatedFormula(readFormula(in));
+  case FORALL:
+  case EXISTS:
+    {
+      Formula::VarList* vars=0;
+      Formula::VarList** vtail=&vars;
+      unsigned cnt=in.readWord();
+      for(unsigned i=0;i<cnt;i++) {
+	*vtail=new Formula::VarList(in.readWord(), 0);
+	vtail=(*vtail)->tailPtr();
+      }
+      Formula::SortList* sorts=0;
+      Formula::SortList** stail=&sorts;
+      cnt=in.readWord();
+      for(unsigned i=0;i<cnt;i++) {
+	*stail=new Formula::SortList(in.readWord(), 0);
+	stail=(*stail)->tailPtr();
+      }
+      return new QuantifiedFormula(con, vars, sorts, readFormula(in));
+    }
+  case TRUE:
+    return new Formula(true);
+  case FALSE:
+    return new Formula(false);
+  default:
+    ASSERTION_VIOLATION;
+    return 0;
+  }
+}
+
+Literal* ParallelTPTP::readLiteral(Input& in)
+{
+  CALL("ParallelTPTP::readLiteral");
+
+  unsigned pred=in.predicate(in.readWord());
+  bool polarity=in.readWord();
+  if(pred==0) {
+    unsigned sort=in.readWord();
+    TermList lhs=readTerm(in);
+    TermList rhs=readTerm(in);
+    return Literal::createEquality(polarity, lhs, rhs, sort);
+  }
+  unsigned arity=env.signature->predicateArity(pred);
+  static Stack<TermList> args;
+  args.reset();
+  for(unsigned i=0;i<arity;i++) {
+    args.push(readTerm(in));
+  }
+  return Literal::create(pred, arity, polarity, false, args.begin());
+}
+
+/**
+ * Read a term written in prefix order by writeLiteral
+ */
+TermList ParallelTPTP::readTerm(Input& in)
+{
+  CALL("ParallelTPTP::readTerm");
+
+  //functors of the terms being read and the positions of their arguments in args
+  static Stack<pair<unsigned,size_t> > frames;
+  static Stack<TermList> args;
+  frames.reset();
+  args.reset();
+
+  for(;;) {
+    unsigned w=in.readWord();
+    TermList t;
+    if(w & VAR_FLAG) {
+      t=TermList(w & ~VAR_FLAG, false);
+    }
+    else {
+      unsigned fn=in.function(w);
+      if(env.signature->functionArity(fn)) {
+	frames.push(make_pair(fn, args.size()));
+	continue;
+      }
+      t=TermList(Term::createConstant(fn));
+    }
+    //complete the terms whose last argument has been read
+    for(;;) {
+      if(frames.isEmpty()) {
+	return t;
+      }
+      args.push(t);
+      unsigned fn=frames.top().first;
+      size_t base=frames.top().second;
+      unsigned arity=env.signature->functionArity(fn);
+      if(args.size()-base<arity) {
+	break;
+      }
+      frames.pop();
+      t=TermList(Term::create(fn, arity, args.begin()+base));
+      args.truncate(base);
+    }
+  }
+}
+
+}
@@ -0,0 +1,112 @@
+/*
+ * File ParallelTPTP.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions.
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide.
+ */
+/**
+ * @file Parse/ParallelTPTP.hpp
+ * Defines class ParallelTPTP for parsing several TPTP files in parallel
+ */
+
+#ifndef __Parser_ParallelTPTP__
+#define __Parser_ParallelTPTP__
+
+#include "Forwards.hpp"
+
+#include "Lib/DArray.hpp"
+#include "Lib/Stack.hpp"
+#include "Lib/VString.hpp"
+
+#include "Kernel/Unit.hpp"
+
+namespace Parse {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Parses TPTP files that are independent of each other, such as the
+ * axiom files of a large-theory batch, in forked worker processes.
+ *
+ * The signature and the term sharing are global and not thread-safe, so
+ * each worker parses every n-th file with Parse::TPTP in its own copy of
+ * them. It writes the units it obtained and the symbols it added to the
+ * signature into a binary file. The parent then rebuilds the units file by
+ * file in the order of the list. The signature, the shared terms and the
+ * unit numbers are the same as if the files had been parsed one after
+ * another in the parent.
+ *
+ * Some files cannot be passed this way, for example files with a
+ * conjecture, interpreted symbols, types or vampire() directives, or files
+ * with a syntax error. The parent parses such a file itself, together with
+ * all later files of the same worker. Errors are therefore reported as by
+ * Parse::TPTP.
+ */
+class ParallelTPTP
+{
+public:
+  ParallelTPTP(const Stack<vstring>& fileNames);
+  ~ParallelTPTP();
+
+  void parse();
+  /** Return the units of the @b i-th file */
+  UnitList* units(unsigned i) const { return _units[i]; }
+  /** Return true if the @b i-th file contains a conjecture */
+  bool containsConjecture(unsigned i) const { return _conjectures[i]; }
+
+private:
+  enum {
+    /** Flag distinguishing variables from symbols in the term words */
+    VAR_FLAG = 0x80000000u
+  };
+
+  class Input;
+
+  static unsigned getNumWorkers();
+
+  void parseHere(unsigned fileIndex);
+  void runWorker(unsigned worker) NO_RETURN;
+  vstring getResultName(unsigned worker) const;
+  void removeResults();
+
+  static bool canWriteSymbols(unsigned firstFunction, unsigned firstPredicate);
+  static bool canWriteUnit(Unit* u);
+  static bool canWriteFormula(Formula* f);
+  static bool canWriteLiteral(Literal* lit);
+
+  static vstring getSymbolKey(const vstring& name);
+  static void writeWord(vstring& out, unsigned w);
+  static void writeString(vstring& out, const vstring& str);
+  static void writeUnit(vstring& out, Unit* u, unsigned firstNumber);
+  static void writeFormula(vstring& out, Formula* f);
+  static void writeLiteral(vstring& out, Literal* lit);
+
+  void readFile(Input& in, unsigned fileIndex);
+  static Unit* readUnit(Input& in, unsigned firstNumber);
+  static Formula* readFormula(Input& in);
+  static Literal* readLiteral(Input& in);
+  static TermList readTerm(Input& in);
+
+  const Stack<vstring>& _fileNames;
+  DArray<UnitList*> _units;
+  DArray<bool> _conjectures;
+  unsigned _workerCnt;
+  /** Private directory for the results of the workers, empty if not created */
+  vstring _resultDir;
+};
+
+}
+
+#endif // __Parser_ParallelTPTP__
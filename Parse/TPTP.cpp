@@ -80,8 +80,12 @@ UnitList* TPTP::parse(istream& input)
  */
 TPTP::TPTP(istream& in)
   : _containsConjecture(false),
+    _containsDeclarations(false),
     _allowedNames(0),
     _in(&in),
+    _mapped(0),
+    _mapBase(0),
+    _ownIn(0),
     _includeDirectory(""),
     _currentColor(COLOR_TRANSPARENT),
     _modelDefinition(false),
@@ -93,11 +97,58 @@ TPTP::TPTP(istream& in)
 } // TPTP::TPTP
 
 /**
- * The destructor, does nothing.
+ * Initialise a lexer reading the file @b fileName. The file is mapped
+ * into memory if possible, so that the characters are not copied into
+ * the buffer of the parser.
+ */
+TPTP::TPTP(const vstring& fileName)
+  : _containsConjecture(false),
+    _containsDeclarations(false),
+    _allowedNames(0),
+    _in(0),
+    _mapped(0),
+    _mapBase(0),
+    _ownIn(0),
+    _includeDirectory(""),
+    _currentColor(COLOR_TRANSPARENT),
+    _modelDefinition(false),
+    _insideEqualityArgument(0),
+    _unitSources(0),
+    _filterReserved(false),
+    _seenConjecture(false)
+{
+  _gpos = 0;
+  openInput(fileName);
+  _ownIn = _in;
+} // TPTP::TPTP
+
+/**
+ * The destructor, releases the input files opened by the parser.
  * @since 09/07/2012 Manchester
  */
 TPTP::~TPTP()
 {
+  CALL("TPTP::~TPTP");
+
+  // only files of unfinished includes can be on the stack
+  while (_mappedInputs.isNonEmpty()) {
+    if (_mapped) {
+      delete _mapped;
+    }
+    else {
+      BYPASSING_ALLOCATOR;
+      delete _in;
+    }
+    _in = _inputs.pop();
+    _mapped = _mappedInputs.pop();
+  }
+  if (_mapped) {
+    delete _mapped;
+  }
+  if (_ownIn) {
+    BYPASSING_ALLOCATOR;
+    delete _ownIn;
+  }
 } // TPTP::~TPTP
 
 /**
@@ -806,8 +857,8 @@ void TPTP::readName(Token& tok)
     case '9':
       break;
     default:
-      ASS(_chars.content()[0] != '$');
-      tok.content.assign(_chars.content(),n);
+      ASS(chars()[0] != '$');
+      tok.content.assign(chars(),n);
       shiftChars(n);
       return;
     }
@@ -891,7 +942,7 @@ void TPTP::readReserved(Token& tok)
     case '9':
       break;
     default:
-      tok.content.assign(_chars.content(),n);
+      tok.content.assign(chars(),n);
       //shiftChars(n);
       goto out;
     }
@@ -963,7 +1014,7 @@ void TPTP::readReserved(Token& tok)
           for(;;c++){ if(getChar(c)!='$') break;}
           shiftChars(c);
           n=n-c;
-          tok.content.assign(_chars.content(),n);
+          tok.content.assign(chars(),n);
       }
       
       tok.tag = T_NAME;
@@ -992,7 +1043,7 @@ void TPTP::readString(Token& tok)
       continue;
     }
     if (c == '"') {
-      tok.content.assign(_chars.content()+1,n-1);
+      tok.content.assign(chars()+1,n-1);
       resetChars();
       return;
     }
@@ -1020,7 +1071,7 @@ void TPTP::readAtom(Token& tok)
       continue;
     }
     if (c == '\'') {
-      tok.content.assign(_chars.content()+1,n-1);
+      tok.content.assign(chars()+1,n-1);
       resetChars();
       return;
     }
@@ -1062,7 +1113,7 @@ TPTP::Tag TPTP::readNumber(Token& tok)
   switch (getChar(pos)) {
   case '/':
     pos = positiveDecimal(pos+1);
-    tok.content.assign(_chars.content(),pos);
+    tok.content.assign(chars(),pos);
     shiftChars(pos);
     return T_RAT;
   case 'E':
@@ -1070,7 +1121,7 @@ TPTP::Tag TPTP::readNumber(Token& tok)
     {
       char c = getChar(pos+1);
       pos = decimal((c == '+' || c == '-') ? pos+2 : pos+1);
-      tok.content.assign(_chars.content(),pos);
+      tok.content.assign(chars(),pos);
       shiftChars(pos);
     }
     return T_REAL;
@@ -1090,12 +1141,12 @@ TPTP::Tag TPTP::readNumber(Token& tok)
 	c = getChar(pos+1);
 	pos = decimal((c == '+' || c == '-') ? pos+2 : pos+1);
       }
-      tok.content.assign(_chars.content(),pos);
+      tok.content.assign(chars(),pos);
       shiftChars(pos);
     }
     return T_REAL;
   default:
-    tok.content.assign(_chars.content(),pos);
+    tok.content.assign(chars(),pos);
     shiftChars(pos);
     return T_INT;
   }
@@ -1191,11 +1242,16 @@ void TPTP::unitList()
       return;
     }
     resetChars();
-    {
+    if (_mapped) {
+      delete _mapped;
+    }
+    else {
       BYPASSING_ALLOCATOR; // ifstream was allocated by "system new"
       delete _in;
     }
     _in = _inputs.pop();
+    _mapped = _mappedInputs.pop();
+    _mapBase = _gpos-_mapOffsets.pop();
     _includeDirectory = _includeDirectories.pop();
     delete _allowedNames;
     _allowedNames = _allowedNamesStack.pop();
@@ -1578,7 +1634,6 @@ void TPTP::include()
   if (!ignore) {
     _allowedNamesStack.push(_allowedNames);
     _allowedNames = 0;
-    _inputs.push(_in);
     _includeDirectories.push(_includeDirectory);
   }
 
@@ -1613,10 +1668,36 @@ void TPTP::include()
   if (ignore) {
     return;
   }
+  // the dot has been consumed together with all characters read so far
+  ASS_EQ(_cend,0);
+  _inputs.push(_in);
+  _mappedInputs.push(_mapped);
+  _mapOffsets.push(_gpos-_mapBase);
   // here should be a computation of the new include directory according to
   // the TPTP standard, so far we just set it to ""
   _includeDirectory = "";
   vstring fileName(env.options->includeFileName(relativeName));
+  _includedFiles.push(fileName);
+  openInput(fileName);
+} // include
+
+/**
+ * Make the file @b fileName the current input. The file is mapped into
+ * memory if possible and read through an ifstream otherwise.
+ */
+void TPTP::openInput(const vstring& fileName)
+{
+  CALL("TPTP::openInput");
+
+  Sys::MappedFile* mapped = new Sys::MappedFile(fileName);
+  if (mapped->isOpen()) {
+    _mapped = mapped;
+    _mapBase = _gpos;
+    _in = 0;
+    return;
+  }
+  delete mapped;
+  _mapped = 0;
   {
     BYPASSING_ALLOCATOR; // we cannot make ifstream allocated via Allocator
     _in = new ifstream(fileName.c_str());
@@ -1624,7 +1705,7 @@ void TPTP::include()
   if (!*_in) {
     USER_ERROR((vstring)"cannot open file " + fileName);
   }
-} // include
+} // openInput
 
 /** add a file name to the list of forbidden includes */
 void TPTP::addForbiddenInclude(vstring file)
@@ -2652,6 +2733,7 @@ Formula* TPTP::createPredicateApplication(vstring name, unsigned arity)
       return distinct_formula;
     }else{
       // Otherwise record them as being in a distinct group
+      _containsDeclarations = true;
       unsigned grpIdx = env.signature->createDistinctGroup(0);
       for(int i = arity-1;i >=0; i--){
         TermList ts = _termLists.pop();
@@ -3199,6 +3281,7 @@ void TPTP::endTff()
   ASS(_types.isEmpty());
 
   OperatorType* ot = constructOperatorType(t);
+  _containsDeclarations = true;
 
   vstring name = _strings.pop();
 
@@ -4174,6 +4257,7 @@ void TPTP::vampire()
 {
   CALL("TPTP::vampire");
 
+  _containsDeclarations = true;
   consumeToken(T_LPAR);
   vstring nm = name();
 
@@ -33,6 +33,7 @@
 #include "Lib/Stack.hpp"
 #include "Lib/Exception.hpp"
 #include "Lib/IntNameTable.hpp"
+#include "Lib/Sys/MappedFile.hpp"
 
 #include "Kernel/Formula.hpp"
 #include "Kernel/Unit.hpp"
@@ -299,6 +300,7 @@ public:
   throw ParseErrorException(msg,tok,_lineNumber)
 
   TPTP(istream& in);
+  TPTP(const vstring& fileName);
   ~TPTP();
   void parse();
   static UnitList* parse(istream& str);
@@ -312,14 +314,22 @@ public:
    * based on this value.
    */
   bool containsConjecture() const { return _containsConjecture; }
+  /**
+   * Return true if the input contained a type declaration, a vampire()
+   * directive or a $distinct group. Their effect is recorded in the
+   * signature or in the options rather than in the parsed units.
+   */
+  bool containsDeclarations() const { return _containsDeclarations; }
   void addForbiddenInclude(vstring file);
+  /** Return the names of the files opened by include() directives */
+  const Stack<vstring>& includedFiles() const { return _includedFiles; }
   static bool findAxiomName(const Unit* unit, vstring& result);
   //this function is used also by the API
   static void assignAxiomName(const Unit* unit, vstring& name);
   unsigned lineNumber(){ return _lineNumber; }
 private:
   /** Return the input string of characters */
-  const char* input() { return _chars.content(); }
+  const char* input() { return chars(); }
 
   enum TypeTag {
     TT_ATOMIC,
@@ -499,6 +509,8 @@ private:
 
   /** true if the input contains a conjecture */
   bool _containsConjecture;
+  /** true if the input contains a declaration, see containsDeclarations() */
+  bool _containsDeclarations;
   /** Allowed names of formulas.
    * If non-null, ignore formulas not included in _allowedNames.
    * This is to support the feature formula_selection of the include
@@ -509,10 +521,25 @@ private:
   Stack<Set<vstring>*> _allowedNamesStack;
   /** set of files whose inclusion should be ignored */
   Set<vstring> _forbiddenIncludes;
-  /** the input stream */
+  /** names of the files opened by include() directives */
+  Stack<vstring> _includedFiles;
+  /** the input stream, 0 if the input is read from @b _mapped */
   istream* _in;
   /** in the case include() is used, previous streams will be saved here */
   Stack<istream*> _inputs;
+  /** the input file mapped into memory, 0 if the input is read from @b _in */
+  Sys::MappedFile* _mapped;
+  /** position in the input (as in _gpos) of the first byte of @b _mapped */
+  int _mapBase;
+  /** in the case include() is used, previous mapped files will be saved here */
+  Stack<Sys::MappedFile*> _mappedInputs;
+  /**
+   * in the case include() is used, offsets in the previous mapped files
+   * at which the parsing continues will be saved here
+   */
+  Stack<int> _mapOffsets;
+  /** the stream the parser opened for the top-level file, if it was not mapped */
+  istream* _ownIn;
   /** the current include directory */
   vstring _includeDirectory;
   /** in the case include() is used, previous sequence of directories will be
@@ -620,6 +647,14 @@ private:
   {
     CALL("TPTP::getChar");
 
+    if (_mapped) {
+      // the characters are read directly from the mapped file
+      if (_cend <= pos) {
+        _cend = pos+1;
+      }
+      size_t i = _gpos-_mapBase+pos;
+      return i < _mapped->size() ? _mapped->data()[i] : 0;
+    }
     while (_cend <= pos) {
       int c = _in->get();
       //      if (c == -1) { cout << "<EOF>"; } else {cout << char(c);}
@@ -637,13 +672,26 @@ private:
     ASS(n > 0);
     ASS(n <= _cend);
 
-    for (int i = 0;i < _cend-n;i++) {
-      _chars[i] = _chars[n+i];
+    if (!_mapped) {
+      for (int i = 0;i < _cend-n;i++) {
+        _chars[i] = _chars[n+i];
+      }
     }
     _cend -= n;
     _gpos += n;
   } // shiftChars
 
+  /**
+   * Return the characters read so far starting with the one at the position 0.
+   */
+  inline const char* chars()
+  {
+    if (_mapped) {
+      return _mapped->data()+(_gpos-_mapBase);
+    }
+    return _chars.content();
+  } // chars
+
   /**
    * Reset the character buffer.
    * @since 10/04/2011 Manchester
@@ -740,6 +788,7 @@ private:
   void endFof();
   void endTff();
   void include();
+  void openInput(const vstring& fileName);
   void type();
   void endIte();
   void letType();
@@ -33,6 +33,9 @@
 
 #include "ClauseDisposer.hpp"
 
+/** Watch stacks of at most this capacity are not moved to smaller ones */
+#define MIN_SHRUNK_WATCH_CAPACITY 64
+
 namespace SAT
 {
 
@@ -109,13 +112,20 @@ void ClauseDisposer::removeUnkept()
   DArray<WatchStack>& watches = getWatchedStackArray();
 
   for(unsigned i=2; i<watchCnt; i++) {
-    WatchStack::Iterator wit(watches[i]);
+    WatchStack& ws = watches[i];
+    WatchStack::Iterator wit(ws);
     while(wit.hasNext()) {
       SATClause* cl = wit.next().cl;
       if(!cl->kept()) {
 	wit.del();
       }
     }
+    if(ws.capacity()>MIN_SHRUNK_WATCH_CAPACITY && ws.size()*4<ws.capacity()) {
+      //most of the watches were removed, so we move the rest to a smaller stack
+      WatchStack compacted(ws.size());
+      compacted.loadFromIterator(WatchStack::BottomFirstIterator(ws));
+      swap(ws, compacted);
+    }
   }
 
   SATClauseStack::StableDelIterator lrnIt(getLearntStack());
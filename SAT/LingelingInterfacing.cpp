@@ -0,0 +1,211 @@
+/*
+ * File LingelingInterfacing.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file LingelingInterfacing.cpp
+ * Implements class LingelingInterfacing
+ */
+
+#include <climits>
+
+#include "LingelingInterfacing.hpp"
+
+namespace SAT
+{
+
+using namespace Shell;  
+using namespace Lib;  
+
+LingelingInterfacing::LingelingInterfacing(const Shell::Options& opts, bool generateProofs):
+  _status(SATISFIABLE), _varCnt(0)
+{
+  CALL("LingelingInterfacing::LingelingInterfacing");
+
+  _solver = lglinit();
+  // the random seed is fixed so that runs are reproducible
+  lglsetopt(_solver, "seed", 0);
+  lglsetopt(_solver, "verbose", -1);
+}
+
+LingelingInterfacing::~LingelingInterfacing()
+{
+  CALL("LingelingInterfacing::~LingelingInterfacing");
+
+  lglrelease(_solver);
+}
+
+/**
+ * Make the solver handle clauses with variables up to @b newVarCnt
+ */
+void LingelingInterfacing::ensureVarCount(unsigned newVarCnt)
+{
+  CALL("LingelingInterfacing::ensureVarCount");
+
+  while(_varCnt < newVarCnt) {
+    lglfreeze(_solver, ++_varCnt);
+  }
+}
+
+unsigned LingelingInterfacing::newVar()
+{
+  CALL("LingelingInterfacing::newVar");
+
+  ensureVarCount(_varCnt+1);
+  return _varCnt;
+}
+
+SATSolver::Status LingelingInterfacing::solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool)
+{
+  CALL("LingelingInterfacing::solveUnderAssumptions");
+
+  ASS(!hasAssumptions());
+
+  _assumptions = assumps;
+
+  solveModuloAssumptionsAndSetStatus(conflictCountLimit);
+
+  if (_status == SATSolver::UNSATISFIABLE) {
+    _failedAssumptionBuffer.reset();
+    SATLiteralStack::Iterator it(_assumptions);
+    while (it.hasNext()) {
+      SATLiteral lit = it.next();
+      if (lglfailed(_solver, vampireLit2Lingeling(lit))) {
+        _failedAssumptionBuffer.push(lit);
+      }
+    }
+  }
+
+  _assumptions.reset();
+
+  return _status;
+}
+
+/**
+ * Solve modulo assumptions and set status.
+ *
+ * Lingeling forgets its assumptions after each call to lglsat,
+ * so they are passed again every time.
+ */
+void LingelingInterfacing::solveModuloAssumptionsAndSetStatus(unsigned conflictCountLimit)
+{
+  CALL("LingelingInterfacing::solveModuloAssumptionsAndSetStatus");
+
+  // -1 means no limit; with the zero limit we also forbid decisions
+  // to get as close as possible to pure unit propagation
+  lglsetopt(_solver, "clim", conflictCountLimit==UINT_MAX ? -1 : (int)min(conflictCountLimit, (unsigned)INT_MAX));
+  lglsetopt(_solver, "dlim", conflictCountLimit==0 ? 0 : -1);
+
+  SATLiteralStack::Iterator it(_assumptions);
+  while (it.hasNext()) {
+    lglassume(_solver, vampireLit2Lingeling(it.next()));
+  }
+
+  switch (lglsat(_solver)) {
+  case LGL_SATISFIABLE:
+    _status = SATISFIABLE;
+    _model.expand(_varCnt+1);
+    for (unsigned v = 1; v <= _varCnt; v++) {
+      _model[v] = lglderef(_solver, v) > 0 ? 1 : -1;
+    }
+    break;
+  case LGL_UNSATISFIABLE:
+    _status = UNSATISFIABLE;
+    break;
+  default:
+    _status = UNKNOWN;
+  }
+}
+
+/**
+ * Add clause into the solver.
+ */
+void LingelingInterfacing::addClause(SATClause* cl)
+{
+  CALL("LingelingInterfacing::addClause");
+
+  // store to later generate the refutation
+  PrimitiveProofRecordingSATSolver::addClause(cl);
+
+  ASS(!hasAssumptions());
+
+  unsigned clen=cl->length();
+  for(unsigned i=0;i<clen;i++) {
+    lgladd(_solver, vampireLit2Lingeling((*cl)[i]));
+  }
+  lgladd(_solver, 0);
+}
+
+/**
+ * Perform solving and return status.
+ */
+SATSolver::Status LingelingInterfacing::solve(unsigned conflictCountLimit)
+{
+  CALL("LingelingInterfacing::solve");
+
+  solveModuloAssumptionsAndSetStatus(conflictCountLimit);
+  return _status;
+}
+
+void LingelingInterfacing::addAssumption(SATLiteral lit)
+{
+  CALL("LingelingInterfacing::addAssumption");
+
+  _assumptions.push(lit);
+}
+
+SATSolver::VarAssignment LingelingInterfacing::getAssignment(unsigned var)
+{
+  CALL("LingelingInterfacing::getAssignment");
+  ASS_EQ(_status, SATISFIABLE);
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  if (var >= _model.size()) {
+    // new vars have been added but the model didn't grow yet
+    return DONT_CARE;
+  }
+  return _model[var] > 0 ? TRUE : FALSE;
+}
+
+bool LingelingInterfacing::isZeroImplied(unsigned var)
+{
+  CALL("LingelingInterfacing::isZeroImplied");
+  ASS_G(var,0); ASS_LE(var,_varCnt);
+
+  return lglfixed(_solver, var) != 0;
+}
+
+void LingelingInterfacing::collectZeroImplied(SATLiteralStack& acc)
+{
+  CALL("LingelingInterfacing::collectZeroImplied");
+
+  for (unsigned v = 1; v <= _varCnt; v++) {
+    int val = lglfixed(_solver, v);
+    if (val) {
+      acc.push(SATLiteral(v, val > 0 ? 1 : 0));
+    }
+  }
+}
+
+SATClause* LingelingInterfacing::getZeroImpliedCertificate(unsigned)
+{
+  CALL("LingelingInterfacing::getZeroImpliedCertificate");
+
+  // not provided, the same as with MinisatInterfacing
+  return 0;
+}
+
+}
@@ -0,0 +1,116 @@
+/*
+ * File LingelingInterfacing.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file LingelingInterfacing.hpp
+ * Defines class LingelingInterfacing
+ */
+#ifndef __LingelingInterfacing__
+#define __LingelingInterfacing__
+
+#include "Lib/DArray.hpp"
+
+#include "SATSolver.hpp"
+#include "SATLiteral.hpp"
+#include "SATClause.hpp"
+
+extern "C" {
+#include "lglib.h"
+}
+
+namespace SAT{
+
+/**
+ * Incremental SAT solving by the Lingeling library (SAT/lglib.c)
+ *
+ * Vampire's variable n is Lingeling's variable n. Every variable is frozen
+ * when created, because clauses and assumptions over any variable may still
+ * come, so Lingeling's inprocessing never eliminates a variable we know of.
+ */
+class LingelingInterfacing : public PrimitiveProofRecordingSATSolver
+{
+public: 
+  CLASS_NAME(LingelingInterfacing);
+  USE_ALLOCATOR(LingelingInterfacing);
+  
+  LingelingInterfacing(const Shell::Options& opts, bool generateProofs=false);
+  virtual ~LingelingInterfacing();
+
+  /**
+   * Can be called only when all assumptions are retracted
+   *
+   * A requirement is that in a clause, each variable occurs at most once.
+   */
+  virtual void addClause(SATClause* cl) override;
+
+  virtual Status solve(unsigned conflictCountLimit) override;
+  
+  /**
+   * If status is @c SATISFIABLE, return assignment of variable @c var
+   */
+  virtual VarAssignment getAssignment(unsigned var) override;
+
+  virtual bool isZeroImplied(unsigned var) override;
+  virtual void collectZeroImplied(SATLiteralStack& acc) override;
+  virtual SATClause* getZeroImpliedCertificate(unsigned var) override;
+
+  virtual void ensureVarCount(unsigned newVarCnt) override;
+  virtual unsigned newVar() override;
+  
+  virtual void suggestPolarity(unsigned var, unsigned pol) override {
+    CALL("LingelingInterfacing::suggestPolarity");
+    lglsetphase(_solver, vampireLit2Lingeling(SATLiteral(var,pol)));
+  }
+  
+  virtual void addAssumption(SATLiteral lit) override;
+  
+  virtual void retractAllAssumptions() override {
+    _assumptions.reset();
+    _status = UNKNOWN;
+  };
+  
+  virtual bool hasAssumptions() const override {
+    return _assumptions.isNonEmpty();
+  };
+
+  virtual void recordSource(unsigned satlitvar, Literal* lit) override {
+    // unsupported by lingeling; intentionally no-op
+  };
+  
+  Status solveUnderAssumptions(const SATLiteralStack& assumps, unsigned conflictCountLimit, bool) override;
+
+protected:
+  void solveModuloAssumptionsAndSetStatus(unsigned conflictCountLimit);
+
+  int vampireLit2Lingeling(SATLiteral vlit) {
+    ASS_G(vlit.var(),0); ASS_LE(vlit.var(),_varCnt);
+    return vlit.isNegative() ? -(int)vlit.var() : (int)vlit.var();
+  }
+
+private:
+  Status _status;
+  LGL* _solver;
+  /** number of variables created in @b _solver */
+  unsigned _varCnt;
+  SATLiteralStack _assumptions;
+  /** lglderef values (1 or -1) of variables in the last model, 0 for variables created since */
+  DArray<signed char> _model;
+};
+
+}//end SAT namespace
+
+#endif /*LingelingInterfacing*/
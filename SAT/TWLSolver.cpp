@@ -830,6 +830,19 @@ SATClause* TWLSolver::propagate(unsigned var)
     Watch watch=wit.next();
     SATClause* cl = watch.cl;
 
+    if(watch.binary) {
+      //the blocker is the other literal, so the clause need not be visited
+      ASS_EQ(cl->length(), 2);
+      if(isTrue(watch.blocker)) {
+	continue;
+      }
+      if(isFalse(watch.blocker)) {
+	return cl;
+      }
+      makeForcedAssignment(watch.blocker, cl);
+      continue;
+    }
+
     unsigned litIndex;
     ClauseVisitResult cvr = visitWatchedClause(watch, var, litIndex);
     switch(cvr) {
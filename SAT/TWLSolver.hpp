@@ -45,15 +45,24 @@ namespace SAT {
 using namespace Lib;
 using namespace Shell;
 
+/**
+ * Entry of a watch list.
+ *
+ * The blocker is a watched literal of @b cl whose truth makes visiting
+ * the clause unnecessary. For binary clauses the blocker is the other
+ * literal, so the propagation never needs to look at the clause itself.
+ * The @b binary flag occupies padding and does not make the entry larger.
+ */
 struct Watch
 {
   Watch() {}
-  Watch(SATClause* cl, SATLiteral blocker) : blocker(blocker), cl(cl)
+  Watch(SATClause* cl, SATLiteral blocker) : blocker(blocker), binary(cl->length()==2), cl(cl)
   {
     CALL("Watch::Watch/2");
     ASS((*cl)[0]==blocker || (*cl)[1]==blocker);
   }
   SATLiteral blocker;
+  bool binary;
   SATClause* cl;
 };
 
@@ -23,14 +23,21 @@
  */
 
 #include <math.h>
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <unistd.h>
 
 #include "Debug/RuntimeStatistics.hpp"
 
+#include "Lib/DArray.hpp"
 #include "Lib/Environment.hpp"
+#include "Lib/Exception.hpp"
 #include "Lib/Int.hpp"
 #include "Lib/Timer.hpp"
 #include "Kernel/Term.hpp"
 #include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
 #include "Kernel/Signature.hpp"
 #include "Kernel/TermIterators.hpp"
 #include "Shell/Statistics.hpp"
@@ -51,7 +58,10 @@ using namespace Kernel;
 
 
 AWPassiveClauseContainer::AWPassiveClauseContainer(const Options& opt)
-:  _ageQueue(opt), _weightQueue(opt), _balance(0), _size(0), _opt(opt)
+:  _ageQueue(opt), _weightQueue(opt), _balance(0), _size(0),
+   _spillLimit(opt.passiveSpillLimit()), _spillThreshold(_spillLimit), _spillFile(0),
+   _spillFileSize(0), _spillFileGarbage(0),
+   _spillMinAge(UINT_MAX), _spillMinWeightKey(ULLONG_MAX), _opt(opt)
 {
   CALL("AWPassiveClauseContainer::AWPassiveClauseContainer");
 
@@ -71,10 +81,24 @@ AWPassiveClauseContainer::~AWPassiveClauseContainer()
     ASS(cl->store()==Clause::PASSIVE);
     cl->setStore(Clause::NONE);
   }
+
+  //like the clauses above, which keep the reference from forward
+  //simplification, spilled clauses keep their inference objects
+  if (_spillFile) {
+    fclose(_spillFile);
+  }
 }
 
+/**
+ * Return an iterator over the passive clauses
+ *
+ * Spilled clauses are read back into the queues first.
+ */
 ClauseIterator AWPassiveClauseContainer::iterator()
 {
+  if (_spilled.isNonEmpty()) {
+    reloadAll();
+  }
   return pvi( ClauseQueue::Iterator(_weightQueue) );
 }
 
@@ -138,6 +162,21 @@ Comparison AWPassiveClauseContainer::compareWeight(Clause* cl1, Clause* cl2, con
   return Int::compare(cl1Weight, cl2Weight);
 }
 
+/**
+ * Return a number such that ordering clauses by it gives the same result
+ * as ordering them by @b compareWeight()
+ */
+unsigned long long AWPassiveClauseContainer::weightKey(Clause* cl, const Options& opt)
+{
+  CALL("AWPassiveClauseContainer::weightKey");
+
+  unsigned long long weight=cl->weight();
+  if (opt.increasedNumeralWeight()) {
+    weight=weight*2+cl->getNumeralWeight();
+  }
+  return weight*(cl->isGoal() ? opt.nonGoalWeightCoeffitientDenominator() : opt.nonGoalWeightCoeffitientNumerator());
+}
+
 /**
  * Comparison of clauses. The comparison uses four orders in the
  * following order:
@@ -262,7 +301,9 @@ Clause* AWPassiveClauseContainer::popSelected()
   CALL("AWPassiveClauseContainer::popSelected");
   ASS( ! isEmpty());
 
-  _size--;
+  if (_spillLimit && _size>_spillThreshold) {
+    spill();
+  }
 
   bool byWeight;
   if (! _ageRatio) {
@@ -281,6 +322,11 @@ Clause* AWPassiveClauseContainer::popSelected()
     byWeight = (_ageRatio <= _weightRatio);
   }
 
+  if (_spilled.isNonEmpty() && reloadNeeded(byWeight)) {
+    reload(byWeight);
+  }
+  _size--;
+
   if (byWeight) {
     _balance -= _ageRatio;
     Clause* cl = _weightQueue.pop();
@@ -295,7 +341,390 @@ Clause* AWPassiveClauseContainer::popSelected()
   return cl;
 } // AWPassiveClauseContainer::popSelected
 
+namespace {
+
+/**
+ * Header of a spilled clause in the spill file, followed by its literals
+ *
+ * The file lives only as long as the process that wrote it, so pointers
+ * to shared literals, to the (kept) inference object and to the (shared, possibly
+ * empty) split set are stored as they are.
+ */
+struct SpillRecord
+{
+  Inference* inference;
+  SplitSet* splits;
+  unsigned number;
+  unsigned length;
+  unsigned age;
+  unsigned inputType;
+  unsigned inductionDepth;
+  bool theoryDescendant;
+};
+
+/** Size of the record of a clause of length @b length in the spill file */
+long spillRecordSize(unsigned length)
+{
+  return sizeof(SpillRecord)+length*sizeof(Literal*);
+}
+
+}
+
+/**
+ * Orders spill entries by decreasing age, so that the
+ * oldest clauses end up on the top of the stack
+ */
+struct AWPassiveClauseContainer::SpillAgeGreater
+{
+  bool operator()(const SpillEntry& e1, const SpillEntry& e2) const
+  { return e1.age>e2.age; }
+};
+
+/**
+ * Orders spill entries by decreasing @b weightKey(), so that the
+ * lightest clauses end up on the top of the stack
+ */
+struct AWPassiveClauseContainer::SpillWeightGreater
+{
+  bool operator()(const SpillEntry& e1, const SpillEntry& e2) const
+  { return e1.weightKey>e2.weightKey; }
+};
+
+/**
+ * True if @b cl can be written out to the spill file, i.e. nothing
+ * else refers to the clause object
+ *
+ * The only reference a passive clause always has is the one taken when
+ * it passed forward simplification, it is restored on reload.
+ */
+bool AWPassiveClauseContainer::canSpill(Clause* cl)
+{
+  CALL("AWPassiveClauseContainer::canSpill");
 
+  return cl->refCnt()==1 && !cl->isFromPreprocessing() && cl->noSplits() &&
+    !cl->isComponent() && !cl->isExtensionality();
+}
+
+/**
+ * Move the clauses that would be selected last to the spill file, so
+ * that only about half of @b _spillLimit clauses remain in the queues
+ *
+ * A spilled clause stays passive, only its inference object stays in
+ * memory. Another spill is not attempted before the queues grow by
+ * half of @b _spillLimit, so that clauses which cannot be spilled
+ * do not make every selection simulate the queues.
+ */
+void AWPassiveClauseContainer::spill()
+{
+  CALL("AWPassiveClauseContainer::spill");
+
+  if (!_spillFile) {
+    _spillFile = tmpfile();
+    if (!_spillFile) {
+      SYSTEM_FAIL("Cannot create the file for spilling passive clauses.",errno);
+    }
+  }
+
+  ClauseQueue::Iterator wit(_weightQueue);
+  ClauseQueue::Iterator ait(_ageQueue);
+  Clause* wcl=0;
+  Clause* acl=0;
+  simulateSelection(_spillLimit/2, false, wit, ait, wcl, acl);
+
+  static Stack<Clause*> toSpill(256);
+  ASS(toSpill.isEmpty());
+  if (_weightRatio) {
+    //clauses after wcl in the weight queue that are also after acl in the age queue
+    while (wit.hasNext()) {
+      Clause* cl=wit.next();
+      if ((!_ageRatio || !acl || _ageQueue.lessThan(acl, cl)) && canSpill(cl)) {
+        toSpill.push(cl);
+      }
+    }
+  }
+  else {
+    while (ait.hasNext()) {
+      Clause* cl=ait.next();
+      if (canSpill(cl)) {
+        toSpill.push(cl);
+      }
+    }
+  }
+
+  if (toSpill.isNonEmpty() && fseek(_spillFile, _spillFileSize, SEEK_SET)!=0) {
+    SYSTEM_FAIL("Cannot write to the file for spilling passive clauses.",errno);
+  }
+  while (toSpill.isNonEmpty()) {
+    Clause* cl=toSpill.pop();
+
+    SpillRecord rec;
+    rec.inference=cl->inference();
+    rec.splits=cl->splits();
+    rec.number=cl->number();
+    rec.length=cl->length();
+    rec.age=cl->age();
+    rec.inputType=cl->inputType();
+    rec.inductionDepth=cl->inductionDepth();
+    rec.theoryDescendant=cl->isTheoryDescendant();
+    if (fwrite(&rec, sizeof(rec), 1, _spillFile)!=1 ||
+        fwrite(cl->literals(), sizeof(Literal*), rec.length, _spillFile)!=rec.length) {
+      SYSTEM_FAIL("Cannot write to the file for spilling passive clauses.",errno);
+    }
+
+    SpillEntry ent;
+    ent.offset=_spillFileSize;
+    ent.length=rec.length;
+    ent.age=rec.age;
+    ent.weightKey=weightKey(cl, _opt);
+    _spilled.push(ent);
+    _spillFileSize+=spillRecordSize(rec.length);
+    _spillMinAge=min(_spillMinAge, ent.age);
+    _spillMinWeightKey=min(_spillMinWeightKey, ent.weightKey);
+
+    if (_ageRatio) {
+      ALWAYS(_ageQueue.remove(cl));
+    }
+    if (_weightRatio) {
+      ALWAYS(_weightQueue.remove(cl));
+    }
+    _size--;
+    spilledEvent.fire(cl);
+    cl->destroyExceptInferenceObject();
+    RSTAT_CTR_INC("passive clauses spilled");
+  }
+
+  _spillThreshold=max(_spillLimit, _size+_spillLimit/2);
+}
+
+/**
+ * True if the next selection by weight (if @b byWeight) or by age
+ * could pick a spilled clause
+ */
+bool AWPassiveClauseContainer::reloadNeeded(bool byWeight)
+{
+  CALL("AWPassiveClauseContainer::reloadNeeded");
+  ASS(_spilled.isNonEmpty());
+
+  ClauseQueue& queue = byWeight ? static_cast<ClauseQueue&>(_weightQueue) : _ageQueue;
+  if (queue.isEmpty()) {
+    return true;
+  }
+  Clause* first=ClauseQueue::Iterator(queue).next();
+  if (byWeight) {
+    return weightKey(first, _opt)>=_spillMinWeightKey;
+  }
+  return first->age()>=_spillMinAge;
+}
+
+/**
+ * Read back the spilled clauses that the selection by weight (if @b byWeight)
+ * or by age is about to reach
+ *
+ * A quarter of @b _spillLimit clauses with the least key is read, together with
+ * all spilled clauses sharing the key of the last one, so that afterwards the
+ * selection is decided by the queues again.
+ */
+void AWPassiveClauseContainer::reload(bool byWeight)
+{
+  CALL("AWPassiveClauseContainer::reload");
+
+  if (byWeight) {
+    std::sort(_spilled.begin(), _spilled.end(), SpillWeightGreater());
+  }
+  else {
+    std::sort(_spilled.begin(), _spilled.end(), SpillAgeGreater());
+  }
+
+  unsigned batch=max(1u, _spillLimit/4);
+  unsigned long long lastKey=0;
+  for (unsigned cnt=0; _spilled.isNonEmpty(); cnt++) {
+    const SpillEntry& ent=_spilled.top();
+    unsigned long long key = byWeight ? ent.weightKey : ent.age;
+    if (cnt>=batch && key!=lastKey) {
+      break;
+    }
+    lastKey=key;
+    insertReloaded(readSpilled(_spilled.pop()));
+  }
+
+  _spillMinAge=UINT_MAX;
+  _spillMinWeightKey=ULLONG_MAX;
+  Stack<SpillEntry>::Iterator sit(_spilled);
+  while (sit.hasNext()) {
+    const SpillEntry& ent=sit.next();
+    _spillMinAge=min(_spillMinAge, ent.age);
+    _spillMinWeightKey=min(_spillMinWeightKey, ent.weightKey);
+  }
+  ASS(_spilled.isEmpty() || !reloadNeeded(byWeight));
+
+  if (_spilled.isEmpty() || _spillFileGarbage>_spillFileSize/2) {
+    compactSpillFile();
+  }
+  //the reloaded clauses are about to be selected, do not spill them right away
+  _spillThreshold=max(_spillThreshold, _size+_spillLimit/2);
+}
+
+/**
+ * Read all spilled clauses back into the queues
+ */
+void AWPassiveClauseContainer::reloadAll()
+{
+  CALL("AWPassiveClauseContainer::reloadAll");
+
+  while (_spilled.isNonEmpty()) {
+    insertReloaded(readSpilled(_spilled.pop()));
+  }
+  _spillMinAge=UINT_MAX;
+  _spillMinWeightKey=ULLONG_MAX;
+  compactSpillFile();
+}
+
+/**
+ * Put the clause @b cl read from the spill file back into the queues
+ */
+void AWPassiveClauseContainer::insertReloaded(Clause* cl)
+{
+  CALL("AWPassiveClauseContainer::insertReloaded");
+
+  cl->setStore(Clause::PASSIVE);
+  //the reference from SaturationAlgorithm::forwardSimplify
+  cl->incRefCnt();
+  if (_ageRatio) {
+    _ageQueue.insert(cl);
+  }
+  if (_weightRatio) {
+    _weightQueue.insert(cl);
+  }
+  _size++;
+  reloadedEvent.fire(cl);
+  RSTAT_CTR_INC("passive clauses reloaded");
+}
+
+/**
+ * Recreate the clause of @b ent from the spill file, with the number it had
+ */
+Clause* AWPassiveClauseContainer::readSpilled(const SpillEntry& ent)
+{
+  CALL("AWPassiveClauseContainer::readSpilled");
+
+  SpillRecord rec;
+  if (fseek(_spillFile, ent.offset, SEEK_SET)!=0 || fread(&rec, sizeof(rec), 1, _spillFile)!=1) {
+    SYSTEM_FAIL("Cannot read from the file for spilling passive clauses.",errno);
+  }
+  ASS_EQ(rec.length, ent.length);
+
+  unsigned lastNumber=Unit::getLastNumber();
+  Unit::setLastNumber(rec.number-1);
+  Clause* cl=new(rec.length) Clause(rec.length, static_cast<Unit::InputType>(rec.inputType), rec.inference);
+  Unit::setLastNumber(lastNumber);
+  ASS_EQ(cl->number(), rec.number);
+
+  if (fread(cl->literals(), sizeof(Literal*), rec.length, _spillFile)!=rec.length) {
+    SYSTEM_FAIL("Cannot read from the file for spilling passive clauses.",errno);
+  }
+  cl->setAge(rec.age);
+  cl->setSplits(rec.splits);
+  cl->setInductionDepth(rec.inductionDepth);
+  cl->setTheoryDescendant(rec.theoryDescendant);
+
+  _spillFileGarbage+=spillRecordSize(rec.length);
+  return cl;
+}
+
+/**
+ * Rewrite the spill file so that it holds only the clauses that are still spilled
+ */
+void AWPassiveClauseContainer::compactSpillFile()
+{
+  CALL("AWPassiveClauseContainer::compactSpillFile");
+
+  if (_spilled.isEmpty()) {
+    rewind(_spillFile);
+    if (ftruncate(fileno(_spillFile), 0)!=0) {
+      SYSTEM_FAIL("Cannot truncate the file for spilling passive clauses.",errno);
+    }
+    _spillFileSize=0;
+    _spillFileGarbage=0;
+    return;
+  }
+
+  FILE* compacted=tmpfile();
+  if (!compacted) {
+    SYSTEM_FAIL("Cannot create the file for spilling passive clauses.",errno);
+  }
+  static DArray<char> buf;
+  long size=0;
+  Stack<SpillEntry>::Iterator sit(_spilled);
+  while (sit.hasNext()) {
+    SpillEntry& ent=sit.next();
+    long recSize=spillRecordSize(ent.length);
+    buf.ensure(recSize);
+    if (fseek(_spillFile, ent.offset, SEEK_SET)!=0 || fread(buf.array(), recSize, 1, _spillFile)!=1) {
+      SYSTEM_FAIL("Cannot read from the file for spilling passive clauses.",errno);
+    }
+    if (fwrite(buf.array(), recSize, 1, compacted)!=1) {
+      SYSTEM_FAIL("Cannot write to the file for spilling passive clauses.",errno);
+    }
+    ent.offset=size;
+    size+=recSize;
+  }
+  fclose(_spillFile);
+  _spillFile=compacted;
+  _spillFileSize=size;
+  _spillFileGarbage=0;
+}
+
+
+
+/**
+ * Advance @b wit and @b ait over the first @b cnt clauses that would be
+ * selected, assigning to @b wcl and @b acl the last clause reached in the
+ * weight and in the age queue respectively (they are left unchanged if
+ * the respective queue is not reached). If @b weightOnly is true and
+ * weight selection is used at all, only the weight queue is followed.
+ */
+void AWPassiveClauseContainer::simulateSelection(long long cnt, bool weightOnly, ClauseQueue::Iterator& wit,
+    ClauseQueue::Iterator& ait, Clause*& wcl, Clause*& acl)
+{
+  CALL("AWPassiveClauseContainer::simulateSelection");
+
+  long long remains=cnt;
+  if (_ageRatio==0 || (weightOnly && _weightRatio!=0) ) {
+    ASS(wit.hasNext());
+    while ( remains && wit.hasNext() ) {
+      wcl=wit.next();
+      remains--;
+    }
+  } else if (_weightRatio==0) {
+    ASS(ait.hasNext());
+    while ( remains && ait.hasNext() ) {
+      acl=ait.next();
+      remains--;
+    }
+  } else {
+    ASS(wit.hasNext()&&ait.hasNext());
+
+    int balance=(_ageRatio<=_weightRatio)?1:0;
+    while (remains) {
+      ASS_G(remains,0);
+      if ( (balance>0 || !ait.hasNext()) && wit.hasNext()) {
+        wcl=wit.next();
+        if (!acl || _ageQueue.lessThan(acl, wcl)) {
+          balance-=_ageRatio;
+          remains--;
+        }
+      } else if (ait.hasNext()){
+        acl=ait.next();
+        if (!wcl || _weightQueue.lessThan(wcl, acl)) {
+          balance+=_weightRatio;
+          remains--;
+        }
+      } else {
+        break;
+      }
+    }
+  }
+}
 
 void AWPassiveClauseContainer::updateLimits(long long estReachableCnt)
 {
@@ -319,44 +748,9 @@ void AWPassiveClauseContainer::updateLimits(long long estReachableCnt)
       return;
     }
 
-    long long remains=estReachableCnt;
     Clause* wcl=0;
     Clause* acl=0;
-    if (_ageRatio==0 || (_opt.lrsWeightLimitOnly() && _weightRatio!=0) ) {
-      ASS(wit.hasNext());
-      while ( remains && wit.hasNext() ) {
-	wcl=wit.next();
-	remains--;
-      }
-    } else if (_weightRatio==0) {
-      ASS(ait.hasNext());
-      while ( remains && ait.hasNext() ) {
-	acl=ait.next();
-	remains--;
-      }
-    } else {
-      ASS(wit.hasNext()&&ait.hasNext());
-
-      int balance=(_ageRatio<=_weightRatio)?1:0;
-      while (remains) {
-	ASS_G(remains,0);
-	if ( (balance>0 || !ait.hasNext()) && wit.hasNext()) {
-	  wcl=wit.next();
-	  if (!acl || _ageQueue.lessThan(acl, wcl)) {
-	    balance-=_ageRatio;
-	    remains--;
-	  }
-	} else if (ait.hasNext()){
-	  acl=ait.next();
-	  if (!wcl || _weightQueue.lessThan(wcl, acl)) {
-	    balance+=_weightRatio;
-	    remains--;
-	  }
-	} else {
-	  break;
-	}
-      }
-    }
+    simulateSelection(estReachableCnt, _opt.lrsWeightLimitOnly(), wit, ait, wcl, acl);
 
     //when _ageRatio==0, the age limit can be set to zero, as age doesn't matter
     maxAge=(_ageRatio && acl!=0)?-1:0;
@@ -25,6 +25,8 @@
 #ifndef __AWPassiveClauseContainer__
 #define __AWPassiveClauseContainer__
 
+#include <cstdio>
+
 #include "Lib/Comparison.hpp"
 #include "Kernel/Clause.hpp"
 #include "Kernel/ClauseQueue.hpp"
@@ -84,20 +86,35 @@ public:
   Clause* popSelected();
   /** True if there are no passive clauses */
   bool isEmpty() const
-  { return _ageQueue.isEmpty() && _weightQueue.isEmpty(); }
+  { return _ageQueue.isEmpty() && _weightQueue.isEmpty() && _spilled.isEmpty(); }
 
   ClauseIterator iterator();
 
   void updateLimits(long long estReachableCnt);
 
-  virtual unsigned size() const { return _size; }
-
+  virtual unsigned size() const { return _size+_spilled.size(); }
 
   static Comparison compareWeight(Clause* cl1, Clause* cl2, const Options& opt);
+  static unsigned long long weightKey(Clause* cl, const Options& opt);
 protected:
   void onLimitsUpdated(LimitsChangeType change);
 
 private:
+  void simulateSelection(long long cnt, bool weightOnly, ClauseQueue::Iterator& wit,
+      ClauseQueue::Iterator& ait, Clause*& wcl, Clause*& acl);
+
+  struct SpillEntry;
+  struct SpillAgeGreater;
+  struct SpillWeightGreater;
+
+  bool canSpill(Clause* cl);
+  void spill();
+  bool reloadNeeded(bool byWeight);
+  void reload(bool byWeight);
+  void reloadAll();
+  void insertReloaded(Clause* cl);
+  Clause* readSpilled(const SpillEntry& ent);
+  void compactSpillFile();
 
   /** The age queue, empty if _ageRatio=0 */
   AgeQueue _ageQueue;
@@ -111,8 +128,35 @@ private:
    * then by weight */
   int _balance;
 
+  /** number of clauses in the queues */
   unsigned _size;
 
+  /** maximal number of clauses kept in the queues, 0 if spilling is off */
+  unsigned _spillLimit;
+  /** the queues are spilled only when they hold more clauses than this */
+  unsigned _spillThreshold;
+  /** temporary file with the spilled clauses, or 0 if not created yet */
+  FILE* _spillFile;
+  /** size of the spill file */
+  long _spillFileSize;
+  /** bytes of the spill file taken by clauses that were read back */
+  long _spillFileGarbage;
+
+  /** Position and selection keys of a clause in the spill file */
+  struct SpillEntry
+  {
+    long offset;
+    unsigned length;
+    unsigned age;
+    unsigned long long weightKey;
+  };
+  /** the spilled clauses */
+  Stack<SpillEntry> _spilled;
+  /** the least age of a spilled clause */
+  unsigned _spillMinAge;
+  /** the least @b weightKey() of a spilled clause */
+  unsigned long long _spillMinWeightKey;
+
   const Options& _opt;
 }; // class AWPassiveClauseContainer
 
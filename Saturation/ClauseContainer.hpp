@@ -120,6 +120,14 @@ public:
   Clause* pop();
   bool isEmpty() const
   { return _data.isEmpty(); }
+  unsigned size() const
+  { return _data.size(); }
+  /**
+   * Return the clause that the @b n-th next call to @b pop() returns,
+   * provided no clauses are added in between (0 is the next one)
+   */
+  Clause* peek(unsigned n) const
+  { return _data[_data.size()-1-n]; }
 private:
   Deque<Clause*> _data;
 };
@@ -131,6 +139,19 @@ public:
   CLASS_NAME(PassiveClauseContainer);
   USE_ALLOCATOR(PassiveClauseContainer);
 
+  /**
+   * This event fires when a clause is moved out of memory by
+   * the container. The clause stays passive, but its object is
+   * destroyed after the event, so it must be dropped from any
+   * index. The clause comes back through @b reloadedEvent.
+   */
+  ClauseEvent spilledEvent;
+  /**
+   * This event fires when a spilled clause is read back into the
+   * container. The clause has the number it had before spilling.
+   */
+  ClauseEvent reloadedEvent;
+
   virtual bool isEmpty() const = 0;
   virtual Clause* popSelected() = 0;
 
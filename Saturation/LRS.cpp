@@ -25,6 +25,7 @@
 #include "Lib/Timer.hpp"
 #include "Lib/TimeCounter.hpp"
 #include "Lib/VirtualIterator.hpp"
+#include "Lib/Sys/ProgressChannel.hpp"
 #include "Kernel/Clause.hpp"
 #include "Kernel/LiteralSelector.hpp"
 #include "Shell/Statistics.hpp"
@@ -112,7 +113,8 @@ long long LRS::estimatedReachableCount()
   if(_opt.simulatedTimeLimit()) {
     timeLeft=_opt.simulatedTimeLimit()*100 - currTime;
   } else {
-    timeLeft=_opt.timeLimitInDeciseconds()*100 - currTime;
+    //the portfolio parent may have added time to the limit of this slice
+    timeLeft=(_opt.timeLimitInDeciseconds()+Sys::ProgressChannel::extraTime())*100 - currTime;
   }
   if(timeLeft<=0 || processed<=10) {
     //we end-up here even if there is no time limit (i.e. time limit is set to 0)
@@ -80,6 +80,20 @@ void Otter::onPassiveRemoved(Clause* cl)
   SaturationAlgorithm::onPassiveRemoved(cl);
 }
 
+void Otter::onPassiveSpilled(Clause* cl)
+{
+  CALL("Otter::onPassiveSpilled");
+
+  _simplCont.remove(cl);
+}
+
+void Otter::onPassiveReloaded(Clause* cl)
+{
+  CALL("Otter::onPassiveReloaded");
+
+  _simplCont.add(cl);
+}
+
 void Otter::onClauseRetained(Clause* cl)
 {
   CALL("Otter::onClauseRetained");
@@ -56,6 +56,10 @@ protected:
   void onPassiveAdded(Clause* cl);
   //overrides SaturationAlgorithm::onPassiveRemoved
   void onPassiveRemoved(Clause* cl);
+  //overrides SaturationAlgorithm::onPassiveSpilled
+  void onPassiveSpilled(Clause* cl);
+  //overrides SaturationAlgorithm::onPassiveReloaded
+  void onPassiveReloaded(Clause* cl);
 
   //overrides SaturationAlgorithm::onClauseRetained
   void onClauseRetained(Clause* cl);
@@ -29,6 +29,7 @@
 
 #include "Shell/Options.hpp"
 #include "Shell/Preprocess.hpp"
+#include "Shell/ProblemCache.hpp"
 #include "Shell/Property.hpp"
 #include "Shell/UIHelper.hpp"
 
@@ -86,13 +87,18 @@ using namespace Shell;
  *
  * The result of the loop is in @b env.statistics
  *
+ * If @b cacheFile is nonempty, the preprocessed problem is stored into it
+ * (see ProblemCache) before the saturation starts. The file is only
+ * meant for other processes of the same run, so it records no hash of the
+ * input files.
+ *
  * The content of the @b units list after return from the function is
  * undefined
  *
  * The function does not necessarily return (e.g. in the case of timeout,
  * the process is aborted)
  */
-void ProvingHelper::runVampire(Problem& prb, const Options& opt)
+void ProvingHelper::runVampire(Problem& prb, const Options& opt, const vstring& cacheFile)
 {
   CALL("ProvingHelper::runVampire");
 
@@ -104,6 +110,9 @@ void ProvingHelper::runVampire(Problem& prb, const Options& opt)
 
       Preprocess prepro(opt);
       prepro.preprocess(prb);
+      if (!cacheFile.empty()) {
+        ProblemCache::save(cacheFile, prb, false);
+      }
     }
     runVampireSaturationImpl(prb, opt);
   }
@@ -26,6 +26,8 @@
 
 #include "Forwards.hpp"
 
+#include "Lib/VString.hpp"
+
 namespace Saturation {
 
 using namespace Kernel;
@@ -34,7 +36,7 @@ using namespace Shell;
 class ProvingHelper {
 public:
   static void runVampireSaturation(Problem& prb, const Options& opt);
-  static void runVampire(Problem& prb, const Options& opt);
+  static void runVampire(Problem& prb, const Options& opt, const vstring& cacheFile="");
 private:
   static void runVampireSaturationImpl(Problem& prb, const Options& opt);
 };
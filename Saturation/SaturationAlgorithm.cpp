@@ -21,6 +21,9 @@
  * Implementing SaturationAlgorithm class.
  */
 
+#include <cerrno>
+#include <sys/mman.h>
+
 #include "Debug/RuntimeStatistics.hpp"
 
 #include "Lib/DHSet.hpp"
@@ -31,10 +34,13 @@
 #include "Lib/Timer.hpp"
 #include "Lib/VirtualIterator.hpp"
 #include "Lib/System.hpp"
+#include "Lib/Sys/Multiprocessing.hpp"
+#include "Lib/Sys/ProgressChannel.hpp"
 
 #include "Indexing/LiteralIndexingStructure.hpp"
 
 #include "Kernel/Clause.hpp"
+#include "Kernel/ClauseArena.hpp"
 #include "Kernel/ColorHelper.hpp"
 #include "Kernel/EqHelper.hpp"
 #include "Kernel/FormulaUnit.hpp"
@@ -65,6 +71,7 @@
 #include "Inferences/InnerRewriting.hpp"
 #include "Inferences/TermAlgebraReasoning.hpp"
 #include "Inferences/SLQueryBackwardSubsumption.hpp"
+#include "Inferences/FVBackwardSubsumption.hpp"
 #include "Inferences/Superposition.hpp"
 #include "Inferences/URResolution.hpp"
 #include "Inferences/Instantiation.hpp"
@@ -102,6 +109,16 @@ using namespace Saturation;
 /** Print information about performed backward simplifications */
 #define REPORT_BW_SIMPL 0
 
+/** Values of forward simplification hints */
+enum {
+  /** Nothing is known about the clause */
+  FW_HINT_UNKNOWN = 0,
+  /** No forward simplification engine applies to the clause */
+  FW_HINT_RETAINED = 1,
+  /** FW_HINT_FIRST_ENGINE+i means that the i-th engine is the first one that applies */
+  FW_HINT_FIRST_ENGINE = 2
+};
+
 
 SaturationAlgorithm* SaturationAlgorithm::s_instance = 0;
 
@@ -122,7 +139,8 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
     _theoryInstSimp(0),
 #endif
     _generatedClauseCount(0),
-    _activationLimit(0)
+    _activationLimit(0),
+    _fwSimplificationBatch(opt.forwardSimplificationBatch())
 {
   CALL("SaturationAlgorithm::SaturationAlgorithm");
   ASS_EQ(s_instance, 0);  //there can be only one saturation algorithm at a time
@@ -150,6 +168,8 @@ SaturationAlgorithm::SaturationAlgorithm(Problem& prb, const Options& opt)
   _passive->addedEvent.subscribe(this, &SaturationAlgorithm::onPassiveAdded);
   _passive->removedEvent.subscribe(this, &SaturationAlgorithm::passiveRemovedHandler);
   _passive->selectedEvent.subscribe(this, &SaturationAlgorithm::onPassiveSelected);
+  _passive->spilledEvent.subscribe(this, &SaturationAlgorithm::passiveSpilledHandler);
+  _passive->reloadedEvent.subscribe(this, &SaturationAlgorithm::passiveReloadedHandler);
   _unprocessed->addedEvent.subscribe(this, &SaturationAlgorithm::onUnprocessedAdded);
   _unprocessed->removedEvent.subscribe(this, &SaturationAlgorithm::onUnprocessedRemoved);
   _unprocessed->selectedEvent.subscribe(this, &SaturationAlgorithm::onUnprocessedSelected);
@@ -514,6 +534,7 @@ void SaturationAlgorithm::activeRemovedHandler(Clause* cl)
 {
   CALL("SaturationAlgorithm::activeRemovedHandler");
 
+  _fwSimplificationHints.reset();
   onActiveRemoved(cl);
 }
 
@@ -529,6 +550,28 @@ void SaturationAlgorithm::passiveRemovedHandler(Clause* cl)
   onPassiveRemoved(cl);
 }
 
+/**
+ * This function is subscribed to the spill event of the passive container,
+ * see @b passiveRemovedHandler for the reason.
+ */
+void SaturationAlgorithm::passiveSpilledHandler(Clause* cl)
+{
+  CALL("SaturationAlgorithm::passiveSpilledHandler");
+
+  onPassiveSpilled(cl);
+}
+
+/**
+ * This function is subscribed to the reload event of the passive container,
+ * see @b passiveRemovedHandler for the reason.
+ */
+void SaturationAlgorithm::passiveReloadedHandler(Clause* cl)
+{
+  CALL("SaturationAlgorithm::passiveReloadedHandler");
+
+  onPassiveReloaded(cl);
+}
+
 /**
  * Return time spent by the run of the saturation algorithm
  */
@@ -846,8 +889,12 @@ void SaturationAlgorithm::handleEmptyClause(Clause* cl)
  *
  * If a weight-limit is imposed on clauses, it is being checked
  * by this function as well.
+ *
+ * If @b hint is not FW_HINT_UNKNOWN, it must be the value that
+ * @b getForwardSimplificationHint() returns for @b cl, and the engines
+ * known not to apply to @b cl are skipped.
  */
-bool SaturationAlgorithm::forwardSimplify(Clause* cl)
+bool SaturationAlgorithm::forwardSimplify(Clause* cl, unsigned hint)
 {
   CALL("SaturationAlgorithm::forwardSimplify");
 
@@ -857,10 +904,22 @@ bool SaturationAlgorithm::forwardSimplify(Clause* cl)
     return false;
   }
 
+  unsigned skip = 0;
+  if (hint==FW_HINT_RETAINED) {
+    skip = FwSimplList::length(_fwSimplifiers);
+  }
+  else if (hint!=FW_HINT_UNKNOWN) {
+    skip = hint-FW_HINT_FIRST_ENGINE;
+  }
+
   FwSimplList::Iterator fsit(_fwSimplifiers);
 
   while (fsit.hasNext()) {
     ForwardSimplificationEngine* fse=fsit.next();
+    if (skip) {
+      skip--;
+      continue;
+    }
 
     {
       Clause* replacement = 0;
@@ -875,6 +934,8 @@ bool SaturationAlgorithm::forwardSimplify(Clause* cl)
         return false;
       }
     }
+    //the first engine run on a hinted clause is the one that applies to it
+    ASS_L(hint, FW_HINT_FIRST_ENGINE);
   }
 
   //TODO: hack that only clauses deleted by forward simplification can be destroyed (other destruction needs debugging)
@@ -889,6 +950,102 @@ bool SaturationAlgorithm::forwardSimplify(Clause* cl)
   return true;
 }
 
+/**
+ * Return which forward simplification engine is the first one to apply
+ * to @b cl (FW_HINT_FIRST_ENGINE plus its position in @b _fwSimplifiers),
+ * or FW_HINT_RETAINED if none does
+ *
+ * The replacements that the engines produce are thrown away, so this
+ * function is only to be called in a process that is discarded afterwards.
+ */
+unsigned SaturationAlgorithm::getForwardSimplificationHint(Clause* cl)
+{
+  CALL("SaturationAlgorithm::getForwardSimplificationHint");
+
+  unsigned res = FW_HINT_FIRST_ENGINE;
+  FwSimplList::Iterator fsit(_fwSimplifiers);
+  while (fsit.hasNext()) {
+    ForwardSimplificationEngine* fse=fsit.next();
+    Clause* replacement = 0;
+    ClauseIterator premises = ClauseIterator::getEmpty();
+    if (fse->perform(cl,replacement,premises)) {
+      return res;
+    }
+    res++;
+  }
+  return FW_HINT_RETAINED;
+}
+
+/**
+ * Compute forward simplification hints for the next @b _fwSimplificationBatch
+ * clauses of the unprocessed container and store them into @b _fwSimplificationHints
+ *
+ * The clauses are split among forked worker processes which report the hints
+ * through shared memory. The engines allocate clauses and insert terms into
+ * the shared term bank, so they cannot run in threads of this process.
+ * A hint stays valid as long as the active container (the simplifying
+ * container of Discount) does not change, which holds until the unprocessed
+ * loop ends or an active clause is removed.
+ */
+void SaturationAlgorithm::computeForwardSimplificationHints()
+{
+  CALL("SaturationAlgorithm::computeForwardSimplificationHints");
+  ASS(_fwSimplificationHints.isEmpty());
+  ASS_L(FwSimplList::length(_fwSimplifiers)+FW_HINT_FIRST_ENGINE, 256);
+
+  unsigned clauseCnt = _fwSimplificationBatch;
+  static ClauseStack batch;
+  batch.reset();
+  for (unsigned i=0; i<clauseCnt; i++) {
+    batch.push(_unprocessed->peek(i));
+  }
+
+  unsigned cores = System::getNumberOfCores();
+  cores = cores < 1 ? 1 : cores;
+  unsigned workerCnt = env.options->multicore();
+  if (!workerCnt || workerCnt>cores) {
+    workerCnt = cores;
+  }
+  if (workerCnt>clauseCnt) {
+    workerCnt = clauseCnt;
+  }
+
+  void* mem = mmap(0, clauseCnt, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (mem==MAP_FAILED) {
+    SYSTEM_FAIL("Call to mmap() failed when computing forward simplification hints.",errno);
+  }
+  //anonymous mappings are zero-filled, so all hints start as FW_HINT_UNKNOWN
+  unsigned char* hints = static_cast<unsigned char*>(mem);
+
+  for (unsigned w=0; w<workerCnt; w++) {
+    pid_t pid = Sys::Multiprocessing::instance()->fork();
+    ASS_NEQ(pid, -1);
+    if (!pid) {
+      try {
+        for (unsigned i=w; i<clauseCnt; i+=workerCnt) {
+          hints[i] = getForwardSimplificationHint(batch[i]);
+        }
+      }
+      catch (...) {
+        System::terminateImmediately(1);
+      }
+      System::terminateImmediately(0);
+    }
+  }
+  for (unsigned w=0; w<workerCnt; w++) {
+    //a worker that failed leaves its hints unknown
+    int exitCode;
+    Sys::Multiprocessing::instance()->waitForChildTermination(exitCode);
+  }
+
+  for (unsigned i=0; i<clauseCnt; i++) {
+    if (hints[i]!=FW_HINT_UNKNOWN) {
+      _fwSimplificationHints.insert(batch[i]->number(), hints[i]);
+    }
+  }
+  munmap(mem, clauseCnt);
+}
+
 /**
  * The the backward simplification with the clause @b cl.
  */
@@ -1073,10 +1230,18 @@ start:
   newClausesToUnprocessed();
 
   while (! _unprocessed->isEmpty()) {
+    if (_fwSimplificationBatch && _fwSimplificationHints.isEmpty() &&
+        _unprocessed->size()>=_fwSimplificationBatch) {
+      computeForwardSimplificationHints();
+    }
+
     Clause* c = _unprocessed->pop();
     ASS(!isRefutation(c));
 
-    if (forwardSimplify(c)) {
+    unsigned hint = FW_HINT_UNKNOWN;
+    _fwSimplificationHints.pop(c->number(), hint);
+
+    if (forwardSimplify(c, hint)) {
       onClauseRetained(c);
       addToPassive(c);
       ASS_EQ(c->store(), Clause::PASSIVE);
@@ -1092,6 +1257,8 @@ start:
       throw TimeLimitExceededException();
     }
   }
+  //onAllProcessed() may change the active container
+  _fwSimplificationHints.reset();
 
   ASS(clausesFlushed());
   onAllProcessed();
@@ -1158,6 +1325,9 @@ void SaturationAlgorithm::doOneAlgorithmStep()
 {
   CALL("SaturationAlgorithm::doOneAlgorithmStep");
 
+  Lib::Sys::ProgressChannel::publish();
+  ClauseArena::endEpoch();
+
   doUnprocessedLoop();
 
   if (_passive->isEmpty()) {
@@ -1448,7 +1618,12 @@ SaturationAlgorithm* SaturationAlgorithm::createFromOptions(Problem& prb, const
   }
   if (opt.backwardSubsumption() != Options::Subsumption::OFF) {
     bool byUnitsOnly=opt.backwardSubsumption()==Options::Subsumption::UNIT_ONLY;
-    res->addBackwardSimplifierToFront(new SLQueryBackwardSubsumption(byUnitsOnly));
+    if (opt.subsumptionIndex()==Options::SubsumptionIndex::FEATURE_VECTOR) {
+      res->addBackwardSimplifierToFront(new FVBackwardSubsumption(byUnitsOnly));
+    }
+    else {
+      res->addBackwardSimplifierToFront(new SLQueryBackwardSubsumption(byUnitsOnly));
+    }
   }
   if (opt.backwardSubsumptionResolution() != Options::Subsumption::OFF) {
     bool byUnitsOnly=opt.backwardSubsumptionResolution()==Options::Subsumption::UNIT_ONLY;
@@ -143,7 +143,8 @@ protected:
   void addInputSOSClause(Clause* cl);
   void newClausesToUnprocessed();
   void addUnprocessedClause(Clause* cl);
-  bool forwardSimplify(Clause* c);
+  bool forwardSimplify(Clause* c, unsigned hint=0);
+  void computeForwardSimplificationHints();
   void backwardSimplify(Clause* c);
   void addToPassive(Clause* c);
   bool activate(Clause* c);
@@ -152,6 +153,8 @@ protected:
   virtual void onActiveRemoved(Clause* c);
   virtual void onPassiveAdded(Clause* c);
   virtual void onPassiveRemoved(Clause* c);
+  virtual void onPassiveSpilled(Clause* c) {}
+  virtual void onPassiveReloaded(Clause* c) {}
   void onPassiveSelected(Clause* c);
   void onUnprocessedAdded(Clause* c);
   void onUnprocessedRemoved(Clause* c);
@@ -164,8 +167,11 @@ protected:
 
 private:
   void passiveRemovedHandler(Clause* cl);
+  void passiveSpilledHandler(Clause* cl);
+  void passiveReloadedHandler(Clause* cl);
   void activeRemovedHandler(Clause* cl);
   void addInputClause(Clause* cl);
+  unsigned getForwardSimplificationHint(Clause* cl);
 
   LiteralSelector& getSosLiteralSelector();
 
@@ -236,6 +242,15 @@ protected:
   unsigned _generatedClauseCount;
 
   unsigned _activationLimit;
+
+  /** Minimal size of unprocessed for which forward simplification hints are computed, 0 if never */
+  unsigned _fwSimplificationBatch;
+  /**
+   * Forward simplification hints of unprocessed clauses, by clause number
+   *
+   * The hints are valid only while the active container does not change.
+   */
+  DHMap<unsigned,unsigned> _fwSimplificationHints;
 };
 
 
@@ -52,6 +52,7 @@
 #include "SAT/BufferedSolver.hpp"
 #include "SAT/FallbackSolverWrapper.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "DP/ShortConflictMetaDP.hpp"
@@ -74,6 +75,7 @@ void SplittingBranchSelector::init()
   CALL("SplittingBranchSelector::init");
 
   _eagerRemoval = _parent.getOptions().splittingEagerRemoval();
+  _incrementalModel = _parent.getOptions().splittingIncrementalModel();
   _literalPolarityAdvice = _parent.getOptions().splittingLiteralPolarityAdvice();
 
   switch(_parent.getOptions().satSolver()){
@@ -83,6 +85,9 @@ void SplittingBranchSelector::init()
     case Options::SatSolver::MINISAT:
       _solver = new MinisatInterfacing(_parent.getOptions(),true);
       break;      
+    case Options::SatSolver::LINGELING:
+      _solver = new LingelingInterfacing(_parent.getOptions(),true);
+      break;
 #if VZ3
     case Options::SatSolver::Z3:
       { BYPASSING_ALLOCATOR
@@ -140,6 +145,9 @@ void SplittingBranchSelector::updateVarCnt()
   // index by var, but ignore slot 0
   _selected.expand(splitLvlCnt+1);
   _trueInCCModel.expand(satVarCnt+1);
+  if(_incrementalModel) {
+    _lastAsgn.expand(satVarCnt+1, SATSolver::NOT_KNOWN);
+  }
 
   // solver may be doing the same, but only internally
   _solver->ensureVarCount(satVarCnt);
@@ -165,6 +173,21 @@ void SplittingBranchSelector::considerPolarityAdvice(SATLiteral lit)
   }
 }
 
+/**
+ * To be called when the component name @b name becomes used.
+ *
+ * The selection of the names of its variable then has to be updated
+ * even if the variable keeps its value in the next model.
+ */
+void SplittingBranchSelector::onNameUsed(SplitLevel name)
+{
+  CALL("SplittingBranchSelector::onNameUsed");
+
+  if(_incrementalModel) {
+    _dirtyVars.push(_parent.getLiteralFromName(name).var());
+  }
+}
+
 static Color colorFromPossiblyDeepFOConversion(SATClause* scl,Unit*& u)
 {
   /* all the clauses added to AVATAR are FO_CONVERSIONs except when there is a duplicate literal
@@ -598,6 +621,10 @@ void SplittingBranchSelector::addSatClauseToSolver(SATClause* cl, bool branchRef
 
   RSTAT_CTR_INC("ssat_sat_clauses");
 
+  if(_incrementalModel && !_resolveNeeded && !isSatisfiedByLastModel(cl)) {
+    _resolveNeeded = true;
+  }
+
   if (branchRefutation && _minSCO) {
     _solver->addClauseIgnoredInPartialModel(cl);
   } else {
@@ -605,6 +632,28 @@ void SplittingBranchSelector::addSatClauseToSolver(SATClause* cl, bool branchRef
   }
 }
 
+/**
+ * Return true if some literal of @b cl is true in the model last passed
+ * to @b updateSelection. Literals of variables without a value count as false.
+ */
+bool SplittingBranchSelector::isSatisfiedByLastModel(SATClause* cl)
+{
+  CALL("SplittingBranchSelector::isSatisfiedByLastModel");
+  ASS(_incrementalModel);
+
+  unsigned clen = cl->length();
+  for(unsigned i=0; i<clen; i++) {
+    SATLiteral lit = (*cl)[i];
+    if(lit.var()>=_lastAsgn.size()) {
+      continue;
+    }
+    if(_lastAsgn[lit.var()]==(lit.polarity() ? SATSolver::TRUE : SATSolver::FALSE)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps, bool randomize)
 {
   CALL("SplittingBranchSelector::recomputeModel");
@@ -612,6 +661,19 @@ void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitL
   ASS(removedComps.isEmpty());
 
   unsigned maxSatVar = _parent.maxSatVar();
+
+  if(_incrementalModel && !_resolveNeeded && !randomize) {
+    // the last model satisfies all the clauses added since, so we keep it
+    // and only update the selection of the newly used names
+    RSTAT_CTR_INC("ssat_model_kept");
+    while(_dirtyVars.isNonEmpty()) {
+      unsigned var = _dirtyVars.pop();
+      if(_lastAsgn[var]!=SATSolver::NOT_KNOWN) {
+        updateSelection(var, _lastAsgn[var], addedComps, removedComps);
+      }
+    }
+    return;
+  }
   
   SATSolver::Status stat;
   {
@@ -633,14 +695,29 @@ void SplittingBranchSelector::recomputeModel(SplitLevelStack& addedComps, SplitL
   }
   ASS_EQ(stat,SATSolver::SATISFIABLE);
 
+  if(_incrementalModel) {
+    _resolveNeeded = false;
+    while(_dirtyVars.isNonEmpty()) {
+      _lastAsgn[_dirtyVars.pop()] = SATSolver::NOT_KNOWN;
+    }
+  }
+
   unsigned _usedcnt=0; // for the statistics below
   for(unsigned i=1; i<=maxSatVar; i++) {
     SATSolver::VarAssignment asgn = getSolverAssimentConsideringCCModel(i);
-    updateSelection(i, asgn, addedComps, removedComps);
     
     if (asgn != SATSolver::DONT_CARE) {
       _usedcnt++;
     }
+
+    if(_incrementalModel) {
+      if(asgn==_lastAsgn[i]) {
+        // the selection of both names of the variable is up to date
+        continue;
+      }
+      _lastAsgn[i] = asgn;
+    }
+    updateSelection(i, asgn, addedComps, removedComps);
   }
   /*
   if(maxSatVar>=1){
@@ -1218,6 +1295,7 @@ Clause* Splitter::buildAndInsertComponentClause(SplitLevel name, unsigned size,
   compCl->setAge(orig ? orig->age() : AGE_NOT_FILLED);
 
   _db[name] = new SplitRecord(compCl);
+  _branchSelector.onNameUsed(name);
   compCl->setSplits(SplitSet::getSingleton(name));
   compCl->setComponent(true);
 
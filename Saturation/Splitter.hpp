@@ -65,7 +65,7 @@ class Splitter;
  */
 class SplittingBranchSelector {
 public:
-  SplittingBranchSelector(Splitter& parent) : _ccModel(false), _parent(parent)  {}
+  SplittingBranchSelector(Splitter& parent) : _ccModel(false), _parent(parent), _resolveNeeded(true)  {}
   ~SplittingBranchSelector(){
 #if VZ3
 {
@@ -80,6 +80,7 @@ _solver=0;
 
   void updateVarCnt();
   void considerPolarityAdvice(SATLiteral lit);
+  void onNameUsed(SplitLevel name);
 
   void addSatClauseToSolver(SATClause* cl, bool refutation);
   void recomputeModel(SplitLevelStack& addedComps, SplitLevelStack& removedComps, bool randomize = false);
@@ -96,8 +97,11 @@ private:
 
   int assertedGroundPositiveEqualityCompomentMaxAge();
 
+  bool isSatisfiedByLastModel(SATClause* cl);
+
   //options
   bool _eagerRemoval;
+  bool _incrementalModel;
   Options::SplittingLiteralPolarityAdvice _literalPolarityAdvice;
   bool _ccMultipleCores;
   bool _minSCO; // minimize wrt splitting clauses only
@@ -120,6 +124,16 @@ private:
    */
   ArraySet _trueInCCModel;
 
+  /**
+   * For each SAT variable the assignment last passed to @b updateSelection,
+   * or NOT_KNOWN if there was none yet. Only maintained in the incremental mode.
+   */
+  DArray<SATSolver::VarAssignment> _lastAsgn;
+  /** Variables that got a newly used name since they were last passed to @b updateSelection */
+  Stack<unsigned> _dirtyVars;
+  /** True if a SAT clause not satisfied by the last model was added since the last solving */
+  bool _resolveNeeded;
+
 #ifdef VDEBUG
   unsigned lastCheckedVar;
 #endif
@@ -177,6 +177,7 @@ cnf_storing_finished:
 
   storage.storeEmptyClausePossession(haveEmptyClause);
   if(haveEmptyClause) {
+    storage.commit();
     return;
   }
 
@@ -280,6 +281,7 @@ cnf_storing_finished:
   }
 
   storage.storeUnitsWithoutSymbols(_unitsWithoutSymbols);
+  storage.commit();
 }
 
 void Builder::updateDefRelation(Unit* u)
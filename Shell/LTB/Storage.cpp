@@ -21,9 +21,29 @@
  * Implements class Storage.
  */
 
+/**
+ * If set to 1, the data are kept by a memcached server listening on the
+ * socket vampire_mc_socket and the vltb executable is linked with
+ * -lmemcached (build it with "make LTB_MEMCACHED=1 vltb"). Otherwise they
+ * are kept in the hash file vampire_ltb_storage that is written by the
+ * Builder and mapped into memory by the Selector.
+ */
+#ifndef LTB_STORAGE_MEMCACHED
+#define LTB_STORAGE_MEMCACHED 0
+#endif
+
 #include <malloc.h>
 #include <string.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <unistd.h>
+
+#if LTB_STORAGE_MEMCACHED
 #include <libmemcached/memcached.h>
+#else
+#include <sys/mman.h>
+#endif
 
 #include "Debug/Assertion.hpp"
 #include "Debug/RuntimeStatistics.hpp"
@@ -35,6 +55,7 @@
 #include "Lib/Int.hpp"
 #include "Lib/Stack.hpp"
 #include "Lib/Vector.hpp"
+#include "Lib/Sys/MappedFile.hpp"
 
 #include "Kernel/Clause.hpp"
 #include "Kernel/Inference.hpp"
@@ -54,6 +75,8 @@ using namespace Kernel;
 
 const unsigned Storage::storedIntMaxSize;
 
+#if LTB_STORAGE_MEMCACHED
+
 class Storage::StorageImpl
 {
 public:
@@ -247,6 +270,9 @@ public:
     if(res!=MEMCACHED_SUCCESS) { ASSERTION_VIOLATION_REP(res); INVALID_OPERATION("memcached fail"); }
   }
 
+  /** The values are available to readers as soon as they are added */
+  void commit() {}
+
 private:
   memcached_st* memc;
   memcached_st memcObj;
@@ -254,6 +280,264 @@ private:
   memcached_result_st resStructObj;
 };
 
+#else
+
+/**
+ * Keeps the data in an open-addressing hash table stored in a file.
+ *
+ * The writer collects the added pairs in memory and @b commit() writes
+ * them out at once. Readers map the file read-only, so that any number
+ * of processes share its pages and values are read directly from the
+ * mapping without any copying or communication.
+ *
+ * The file starts with the words MAGIC, VERSION, the number of buckets
+ * (a power of two) and the number of records, followed by the buckets
+ * and the records. Each bucket is a 64-bit offset of a record in the file,
+ * or zero if the bucket is empty. Each record consists of the key length,
+ * the value length, the key and the value, padded to a multiple of four
+ * bytes. Collisions are resolved by linear probing.
+ */
+class Storage::StorageImpl
+{
+public:
+  StorageImpl() : _file(0), _bucketMask(0), _buckets(0) {}
+  ~StorageImpl()
+  {
+    CALL("Storage::StorageImpl::~StorageImpl");
+
+    delete _file;
+  }
+
+  vstring getString(const char* key, size_t keyLen, bool allowMiss=false)
+  {
+    CALL("Storage::StorageImpl::getString");
+
+    const char* val;
+    size_t valLen;
+    if(!find(key, keyLen, val, valLen)) {
+      if(allowMiss) {
+	return "";
+      }
+      throw StorageCorruptedException();
+    }
+    return vstring(val, valLen);
+  }
+
+  /**
+   * Return values stored under keys. For keys that do not correspond to any value,
+   * empty string is given. Result strings are yielded in the order they are on the
+   * stack (so that the first is the value for keys[0])
+   */
+  StringIterator getStrings(StringStack& keys)
+  {
+    CALL("Storage::StorageImpl::getStrings");
+
+    size_t keyCnt=keys.size();
+    Vector<vstring>* values=Vector<vstring>::allocate(keyCnt);
+    for(size_t i=0;i<keyCnt;i++) {
+      (*values)[i]=getString(keys[i].c_str(), keys[i].size(), true);
+    }
+    return pvi( Vector<vstring>::DestructiveIterator(*values) );
+  }
+
+  void add(const char* key, size_t keyLen, const char* val, size_t valLen)
+  {
+    CALL("Storage::StorageImpl::add");
+    ASS_G(keyLen,0);
+    ASS(!_file);
+    ASS_REP(key[0]==THEORY_FILES || key[0]==PRED_NUM_NAME || key[0]==FUN_NUM_NAME
+	|| key[0]==HAS_EMPTY_CLAUSE || valLen%storedIntMaxSize==0, (int)key[0]);
+
+    _recordOffsets.push(_records.size());
+    appendWord(_records, keyLen);
+    appendWord(_records, valLen);
+    _records.append(key, keyLen);
+    _records.append(val, valLen);
+    _records.append(padding(keyLen+valLen), '\0');
+  }
+
+  /**
+   * Write the added pairs into the storage file. The file is first
+   * written under a temporary name, so that readers never see it
+   * incomplete.
+   */
+  void commit()
+  {
+    CALL("Storage::StorageImpl::commit");
+
+    size_t recCnt=_recordOffsets.size();
+    size_t bucketCnt=2;
+    while(bucketCnt<recCnt*2) {
+      bucketCnt*=2;
+    }
+    size_t headerSize=HEADER_WORDS*sizeof(unsigned);
+    size_t recordStart=headerSize+bucketCnt*sizeof(uint64_t);
+
+    DArray<uint64_t> buckets;
+    buckets.init(bucketCnt, 0);
+    for(size_t i=0;i<recCnt;i++) {
+      const char* rec=_records.c_str()+_recordOffsets[i];
+      unsigned keyLen=readWord(rec);
+      size_t b=hash(rec+RECORD_HEADER_SIZE, keyLen) & (bucketCnt-1);
+      while(buckets[b]) {
+	const char* other=_records.c_str()+(buckets[b]-recordStart);
+	if(readWord(other)==keyLen && !memcmp(other+RECORD_HEADER_SIZE, rec+RECORD_HEADER_SIZE, keyLen)) {
+	  //memcached refused to add an existing key as well
+	  ASSERTION_VIOLATION;
+	  INVALID_OPERATION("duplicate key in the LTB storage");
+	}
+	b=(b+1) & (bucketCnt-1);
+      }
+      buckets[b]=recordStart+_recordOffsets[i];
+    }
+
+    vstring header;
+    appendWord(header, MAGIC);
+    appendWord(header, VERSION);
+    appendWord(header, bucketCnt);
+    appendWord(header, recCnt);
+    ASS_EQ(header.size(), headerSize);
+
+    vstring tmpName=vstring(fileName())+".tmp"+Int::toString(getpid());
+    FILE* f=fopen(tmpName.c_str(), "wb");
+    if(!f) {
+      SYSTEM_FAIL("Cannot create the LTB storage "+tmpName, errno);
+    }
+    bool ok=fwrite(header.c_str(), 1, headerSize, f)==headerSize
+	&& fwrite(buckets.array(), sizeof(uint64_t), bucketCnt, f)==bucketCnt
+	&& fwrite(_records.c_str(), 1, _records.size(), f)==_records.size();
+    ok=(fclose(f)==0) && ok;
+    if(!ok || rename(tmpName.c_str(), fileName())!=0) {
+      int err=errno;
+      remove(tmpName.c_str());
+      SYSTEM_FAIL("Cannot write the LTB storage "+vstring(fileName()), err);
+    }
+  }
+
+private:
+  enum {
+    /** First word of the file, the bytes "VLTB" on little endian machines */
+    MAGIC = 0x42544c56,
+    /** Number of the format version, to be increased when the format changes */
+    VERSION = 1,
+    /** Number of words preceding the buckets */
+    HEADER_WORDS = 4,
+    /** Size of the key and value lengths at the start of each record */
+    RECORD_HEADER_SIZE = 2*sizeof(unsigned)
+  };
+
+  static const char* fileName() { return "vampire_ltb_storage"; }
+
+  static unsigned hash(const char* key, size_t keyLen)
+  {
+    //FNV-1a
+    unsigned res=2166136261u;
+    for(size_t i=0;i<keyLen;i++) {
+      res=(res^static_cast<unsigned char>(key[i]))*16777619u;
+    }
+    return res;
+  }
+
+  static size_t padding(size_t len) { return (4-len%4)%4; }
+
+  static void appendWord(vstring& buf, size_t w)
+  {
+    unsigned val=w;
+    ASS_EQ(val, w);
+    buf.append(reinterpret_cast<const char*>(&val), sizeof(unsigned));
+  }
+
+  static unsigned readWord(const char* ptr)
+  {
+    unsigned res;
+    memcpy(&res, ptr, sizeof(unsigned));
+    return res;
+  }
+
+  /**
+   * Map the storage file into memory and check its header
+   */
+  void open()
+  {
+    CALL("Storage::StorageImpl::open");
+    ASS(!_file);
+    ASS(_recordOffsets.isEmpty());
+
+    _file=new Sys::MappedFile(fileName());
+    if(!_file->isOpen()) {
+      USER_ERROR("Cannot open the LTB storage "+vstring(fileName()));
+    }
+    size_t size=_file->size();
+    const char* data=_file->data();
+    size_t headerSize=HEADER_WORDS*sizeof(unsigned);
+    if(size<headerSize || readWord(data)!=MAGIC || readWord(data+sizeof(unsigned))!=VERSION) {
+      throw StorageCorruptedException();
+    }
+    size_t bucketCnt=readWord(data+2*sizeof(unsigned));
+    if(bucketCnt==0 || (bucketCnt&(bucketCnt-1)) || (size-headerSize)/sizeof(uint64_t)<bucketCnt) {
+      throw StorageCorruptedException();
+    }
+    //lookups go to random places in the file
+    madvise(const_cast<char*>(data), size, MADV_RANDOM);
+    _bucketMask=bucketCnt-1;
+    _buckets=data+headerSize;
+  }
+
+  /**
+   * If there is a value stored under @b key, assign its start and length
+   * to @b val and @b valLen and return true, otherwise return false.
+   * The value points into the mapped file.
+   */
+  bool find(const char* key, size_t keyLen, const char*& val, size_t& valLen)
+  {
+    CALL("Storage::StorageImpl::find");
+
+    if(!_file) {
+      open();
+    }
+    const char* data=_file->data();
+    size_t size=_file->size();
+    size_t b=hash(key, keyLen) & _bucketMask;
+    //the builder leaves at least half of the buckets empty, so a search
+    //that visits every bucket can only happen in a corrupted file
+    for(size_t probes=0; probes<=_bucketMask; probes++) {
+      uint64_t offset;
+      memcpy(&offset, _buckets+b*sizeof(uint64_t), sizeof(uint64_t));
+      if(!offset) {
+	return false;
+      }
+      if(offset>size || size-offset<RECORD_HEADER_SIZE) {
+	throw StorageCorruptedException();
+      }
+      const char* rec=data+offset;
+      size_t recKeyLen=readWord(rec);
+      size_t recValLen=readWord(rec+sizeof(unsigned));
+      if(size-offset-RECORD_HEADER_SIZE<recKeyLen+recValLen) {
+	throw StorageCorruptedException();
+      }
+      if(recKeyLen==keyLen && !memcmp(rec+RECORD_HEADER_SIZE, key, keyLen)) {
+	val=rec+RECORD_HEADER_SIZE+keyLen;
+	valLen=recValLen;
+	return true;
+      }
+      b=(b+1) & _bucketMask;
+    }
+    throw StorageCorruptedException();
+  }
+
+  /** The mapped storage file when reading */
+  Sys::MappedFile* _file;
+  size_t _bucketMask;
+  const char* _buckets;
+
+  /** Records added by the writer, in the format they have in the file */
+  vstring _records;
+  /** Offsets of the records in @b _records */
+  Stack<size_t> _recordOffsets;
+};
+
+#endif
+
 Storage::Storage(bool translateSignature)
 : _translateSignature(translateSignature)
 {
@@ -271,6 +555,17 @@ Storage::~Storage()
   delete _impl;
 }
 
+/**
+ * Make the stored data available for retrieval. Must be called
+ * after all the data have been stored.
+ */
+void Storage::commit()
+{
+  CALL("Storage::commit");
+
+  _impl->commit();
+}
+
 vstring Storage::getConstKey(KeyPrefix p)
 {
   CALL("Storage::getConstKey");
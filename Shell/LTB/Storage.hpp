@@ -101,6 +101,8 @@ public:
 
   void storeEmptyClausePossession(bool hasEmptyClause);
 
+  void commit();
+
 private:
   class StorageImpl;
 
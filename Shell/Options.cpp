@@ -185,9 +185,31 @@ void Options::Options::init()
         Or(_mode.is(equal(Mode::PORTFOLIO)))));
 
     _multicore = UnsignedOptionValue("cores","",1);
-    _multicore.description = "When running in portfolio mode mode specify the number of cores, set to 0 to use maximum";
+    _multicore.description = "When running in portfolio mode mode specify the number of cores, set to 0 to use maximum."
+                             " In sat_solver mode a value other than 1 runs a portfolio of SAT solvers on that many cores."
+                             " With forward_simplification_batch it is the number of processes that simplify a batch";
     _lookup.insert(&_multicore);
     _multicore.reliesOnHard(_mode.is(equal(Mode::CASC)->
+        Or(_mode.is(equal(Mode::CASC_SAT)))->
+        Or(_mode.is(equal(Mode::SMTCOMP)))->
+        Or(_mode.is(equal(Mode::PORTFOLIO)))->
+        Or(_mode.is(equal(Mode::SAT)))->
+        Or<unsigned>(_forwardSimplificationBatch.is(notEqual(0u)))));
+
+    _sharedPreprocessing = BoolOptionValue("shared_preprocessing","",false);
+    _sharedPreprocessing.description = "In portfolio mode, let the first slice of each group of slices that preprocess the problem the same way store its preprocessed problem in a temporary file, from which the later slices of the group load it instead of preprocessing the problem again";
+    _lookup.insert(&_sharedPreprocessing);
+    _sharedPreprocessing.setExperimental();
+    _sharedPreprocessing.reliesOnHard(_mode.is(equal(Mode::CASC)->
+        Or(_mode.is(equal(Mode::CASC_SAT)))->
+        Or(_mode.is(equal(Mode::SMTCOMP)))->
+        Or(_mode.is(equal(Mode::PORTFOLIO)))));
+
+    _sliceStallTime = UnsignedOptionValue("slice_stall_time","",0);
+    _sliceStallTime.description = "In portfolio mode, suspend a running slice that has not activated any clause for this many deciseconds while other slices are waiting for a core. Suspended slices are resumed once the waiting slices have been started and keep the rest of their time limit. Once no slice is waiting, slices that have activated a clause within this time may run past their own time limit until the overall one. 0 means never suspend or extend slices";
+    _lookup.insert(&_sliceStallTime);
+    _sliceStallTime.setExperimental();
+    _sliceStallTime.reliesOnHard(_mode.is(equal(Mode::CASC)->
         Or(_mode.is(equal(Mode::CASC_SAT)))->
         Or(_mode.is(equal(Mode::SMTCOMP)))->
         Or(_mode.is(equal(Mode::PORTFOLIO)))));
@@ -348,6 +370,15 @@ void Options::Options::init()
     _lookup.insert(&_include);
     _include.tag(OptionTag::INPUT);
 
+    _problemCache = StringOptionValue("problem_cache","","");
+    _problemCache.description="File caching the preprocessed problem. If the file was created from the same input files with the same "
+                              "preprocessing options, the problem is loaded from it instead of being parsed and preprocessed, "
+                              "otherwise the file is (re)created after preprocessing. Proofs found on a loaded problem start from "
+                              "the preprocessed clauses, marked as loaded from the problem cache.";
+    _lookup.insert(&_problemCache);
+    _problemCache.tag(OptionTag::INPUT);
+    _problemCache.setExperimental();
+
     _inputFile= InputFileOptionValue("input_file","","",this);
     _inputFile.description="Problem file to be solved (if not specified, standard input is used)";
     _lookup.insert(&_inputFile);
@@ -863,6 +894,15 @@ void Options::Options::init()
 	    _lookup.insert(&_simulatedTimeLimit);
 	    _simulatedTimeLimit.tag(OptionTag::LRS);
 
+	    _passiveSpillLimit = UnsignedOptionValue("passive_spill_limit","",0);
+	    _passiveSpillLimit.description=
+	    "If non-zero, at most this many passive clauses are kept in memory. When there are more, the clauses "
+	    "that will be selected last are written to a temporary file and read back once selection reaches them. "
+	    "Only clauses that are not referenced from elsewhere (e.g. by AVATAR) can be written out.";
+	    _lookup.insert(&_passiveSpillLimit);
+	    _passiveSpillLimit.tag(OptionTag::SATURATION);
+	    _passiveSpillLimit.setExperimental();
+
 
 	//*********************** Inferences  ***********************
 
@@ -1129,6 +1169,27 @@ void Options::Options::init()
     _forwardSubsumption.tag(OptionTag::INFERENCES);
     _forwardSubsumption.setRandomChoices({"on","on","on","on","on","on","on","on","on","off"}); // turn this off rarely
 
+    _forwardSimplificationBatch = UnsignedOptionValue("forward_simplification_batch","fsb",0);
+    _forwardSimplificationBatch.description="When unprocessed holds at least this many clauses, find out in parallel which forward simplification (if any) applies to each of the next this many clauses, so that the main process runs only that one. The work is split over the number of processes given by cores (0 means all available cores). The result is the same as without batching. 0 means off.";
+    _lookup.insert(&_forwardSimplificationBatch);
+    _forwardSimplificationBatch.tag(OptionTag::SATURATION);
+    _forwardSimplificationBatch.addHardConstraint(If(notEqual(0u)).then(_saturationAlgorithm.is(equal(SaturationAlgorithm::DISCOUNT))));
+    _forwardSimplificationBatch.addHardConstraint(If(notEqual(0u)).then(_globalSubsumption.is(equal(false))));
+    _forwardSimplificationBatch.setExperimental();
+
+    _subsumptionIndex = ChoiceOptionValue<SubsumptionIndex>("subsumption_index","sui",
+                                                            SubsumptionIndex::SUBST_TREE,{"subst_tree","feature_vector"});
+    _subsumptionIndex.description="Index retrieving candidate clauses for forward subsumption by non-unit clauses and for backward subsumption. Feature_vector uses a trie over integer features of whole clauses instead of literal substitution trees.";
+    _lookup.insert(&_subsumptionIndex);
+    _subsumptionIndex.tag(OptionTag::INFERENCES);
+    _subsumptionIndex.setExperimental();
+
+    _compactSubstitutionTrees = BoolOptionValue("compact_substitution_trees","",false);
+    _compactSubstitutionTrees.description="Store the children of large substitution tree nodes in sorted arrays with inline top symbols instead of skip lists. Applies to the unification and superposition indices.";
+    _lookup.insert(&_compactSubstitutionTrees);
+    _compactSubstitutionTrees.tag(OptionTag::SATURATION);
+    _compactSubstitutionTrees.setExperimental();
+
     _forwardSubsumptionResolution = BoolOptionValue("forward_subsumption_resolution","fsr",true);
     _forwardSubsumptionResolution.description="Perform forward subsumption resolution.";
     _lookup.insert(&_forwardSubsumptionResolution);
@@ -1273,7 +1334,7 @@ void Options::Options::init()
     _instGenWithResolution.reliesOn(_saturationAlgorithm.is(equal(SaturationAlgorithm::INST_GEN)));
     _instGenWithResolution.setRandomChoices({"on","off"});
 
-    _useHashingVariantIndex = BoolOptionValue("use_hashing_clause_variant_index","uhcvi",false);
+    _useHashingVariantIndex = BoolOptionValue("use_hashing_clause_variant_index","uhcvi",true);
     _useHashingVariantIndex.description= "Use clause variant index based on hashing for clause variant detection (affects inst_gen and avatar).";
     _lookup.insert(&_useHashingVariantIndex);
     _useHashingVariantIndex.tag(OptionTag::OTHER);
@@ -1398,6 +1459,14 @@ void Options::Options::init()
     _splittingBufferedSolver.reliesOn(_splitting.is(equal(true)));
     _splittingBufferedSolver.setRandomChoices({"on","off"});
 
+    _splittingIncrementalModel = BoolOptionValue("avatar_incremental_model","aim",false);
+    _splittingIncrementalModel.description="Keep the last model of the SAT solver while it satisfies all the newly added SAT clauses"
+                                           " and only update the components of variables whose value changed in a new model.";
+    _lookup.insert(&_splittingIncrementalModel);
+    _splittingIncrementalModel.tag(OptionTag::AVATAR);
+    _splittingIncrementalModel.setExperimental();
+    _splittingIncrementalModel.reliesOn(_splitting.is(equal(true)));
+
     _splittingDeleteDeactivated = ChoiceOptionValue<SplittingDeleteDeactivated>("avatar_delete_deactivated","add",
                                                                         SplittingDeleteDeactivated::ON,{"on","large","off"});
 
@@ -1528,12 +1597,12 @@ void Options::Options::init()
 
     _satSolver = ChoiceOptionValue<SatSolver>("sat_solver","sas",SatSolver::MINISAT,
 #if VZ3
-            {"minisat","vampire","z3"});
+            {"minisat","vampire","lingeling","z3"});
 #else
-    {"minisat","vampire"});
+    {"minisat","vampire","lingeling"});
 #endif
     _satSolver.description=
-    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption.";
+    "Select the SAT solver to be used throughout the solver. This will be used in AVATAR (for splitting) when the saturation algorithm is discount,lrs or otter and in instance generation for selection and global subsumption. Lingeling is not available for fmb.";
     _lookup.insert(&_satSolver);
     _satSolver.tag(OptionTag::SAT);
     _satSolver.setRandomChoices(
@@ -2893,6 +2962,69 @@ vstring Options::generateEncodedOptions() const
 }
 
 
+/**
+ * Return a string such that two option sets with the same string
+ * preprocess a problem in the same way.
+ *
+ * The key consists of the non-default values of the options read by
+ * Preprocess and the transformations it calls (including Property::scan
+ * and the clause weight computation). Options that only affect what is
+ * printed are left out. When preprocessing starts to read another
+ * option, it must be added here.
+ */
+vstring Options::generatePreprocessingKey() const
+{
+  CALL("Options::generatePreprocessingKey");
+
+  BYPASSING_ALLOCATOR;
+
+  const AbstractOptionValue* options[] = {
+    &_arityCheck,
+    &_bfnt,
+    &_blockedClauseElimination,
+    &_equalityProxy,
+    &_equalityResolutionWithDeletion,
+    &_equivalentVariableRemoval,
+    &_FOOLParamodulation,
+    &_functionDefinitionElimination,
+    &_generalSplitting,
+    &_guessTheGoal,
+    &_guessTheGoalLimit,
+    &_ignoreConjectureInPreprocessing,
+    &_increasedNumeralWeight,
+    &_induction,
+    &_inequalitySplitting,
+    &_inlineLet,
+    &_naming,
+    &_newCNF,
+    &_nonGoalWeightCoefficient,
+    &_nonliteralsInClauseWeight,
+    &_normalize,
+    &_protectedPrefix,
+    &_questionAnswering,
+    &_restrictNWCtoGC,
+    &_saturationAlgorithm,
+    &_sineDepth,
+    &_sineGeneralityThreshold,
+    &_sineSelection,
+    &_sineTolerance,
+    &_symbolPrecedence,
+    &_termAlgebraCyclicityCheck,
+    &_theoryAxioms,
+    &_theoryFlattening,
+    &_unusedPredicateDefinitionRemoval
+  };
+
+  vostringstream res;
+  for(const AbstractOptionValue* option : options){
+    if(option->isDefault()){
+      continue;
+    }
+    res << option->longName << "=" << option->getStringOfActual() << ":";
+  }
+  return res.str();
+}
+
 /**
  * True if the options are complete.
  * @since 23/07/2011 Manchester
@@ -139,6 +139,7 @@ public:
     void readFromEncodedOptions (vstring testId);
     void readOptionsString (vstring testId,bool assign=true);
     vstring generateEncodedOptions() const;
+    vstring generatePreprocessingKey() const;
 
     // deal with completeness
     bool complete(const Problem&) const;
@@ -506,9 +507,10 @@ public:
   /** Possible values for sat_solver */
   enum class SatSolver : unsigned int {
      MINISAT = 0,
-     VAMPIRE = 1
+     VAMPIRE = 1,
+     LINGELING = 2
 #if VZ3
-     ,Z3 = 2
+     ,Z3 = 3
 #endif
   };
 
@@ -567,6 +569,11 @@ public:
     UNIT_ONLY = 2
   };
 
+  enum class SubsumptionIndex : unsigned int {
+    SUBST_TREE = 0,
+    FEATURE_VECTOR = 1
+  };
+
   enum class URResolution : unsigned int {
     EC_ONLY = 0,
     OFF = 1,
@@ -1846,6 +1853,8 @@ public:
   void setSchedule(Schedule newVal) {  _schedule.actualValue = newVal; }
   unsigned multicore() const { return _multicore.actualValue; }
   void setMulticore(unsigned newVal) { _multicore.actualValue = newVal; }
+  bool sharedPreprocessing() const { return _sharedPreprocessing.actualValue; }
+  unsigned sliceStallTime() const { return _sliceStallTime.actualValue; }
   InputSyntax inputSyntax() const { return _inputSyntax.actualValue; }
   void setInputSyntax(InputSyntax newVal) { _inputSyntax.actualValue = newVal; }
   bool normalize() const { return _normalize.actualValue; }
@@ -1855,6 +1864,7 @@ public:
 
   void setNaming(int n){ _naming.actualValue = n;} //TODO: ensure global constraints
   vstring include() const { return _include.actualValue; }
+  vstring problemCache() const { return _problemCache.actualValue; }
   void setInclude(vstring val) { _include.actualValue = val; }
   vstring logFile() const { return _logFile.actualValue; }
   vstring inputFile() const { return _inputFile.actualValue; }
@@ -1937,12 +1947,16 @@ public:
   //void setBackwardSubsumption(Subsumption newVal) { _backwardSubsumption = newVal; }
   Subsumption backwardSubsumptionResolution() const { return _backwardSubsumptionResolution.actualValue; }
   bool forwardSubsumption() const { return _forwardSubsumption.actualValue; }
+  unsigned forwardSimplificationBatch() const { return _forwardSimplificationBatch.actualValue; }
+  SubsumptionIndex subsumptionIndex() const { return _subsumptionIndex.actualValue; }
+  bool compactSubstitutionTrees() const { return _compactSubstitutionTrees.actualValue; }
   bool forwardLiteralRewriting() const { return _forwardLiteralRewriting.actualValue; }
   int lrsFirstTimeCheck() const { return _lrsFirstTimeCheck.actualValue; }
   int lrsWeightLimitOnly() const { return _lrsWeightLimitOnly.actualValue; }
   int lookaheadDelay() const { return _lookaheadDelay.actualValue; }
   int simulatedTimeLimit() const { return _simulatedTimeLimit.actualValue; }
   void setSimulatedTimeLimit(int newVal) { _simulatedTimeLimit.actualValue = newVal; }
+  unsigned passiveSpillLimit() const { return _passiveSpillLimit.actualValue; }
   int maxInferenceDepth() const { return _maxInferenceDepth.actualValue; }
   TermOrdering termOrdering() const { return _termOrdering.actualValue; }
   SymbolPrecedence symbolPrecedence() const { return _symbolPrecedence.actualValue; }
@@ -2052,6 +2066,7 @@ public:
   float satRestartMinisatIncrease() const { return _satRestartMinisatIncrease.actualValue; }
   int satRestartMinisatInit() const { return _satRestartMinisatInit.actualValue; }
   SatRestartStrategy satRestartStrategy() const { return _satRestartStrategy.actualValue; }
+  void setSatRestartStrategy(SatRestartStrategy newVal) { _satRestartStrategy.actualValue = newVal; }
   float satVarActivityDecay() const { return _satVarActivityDecay.actualValue; }
   SatVarSelector satVarSelector() const { return _satVarSelector.actualValue; }
 
@@ -2075,6 +2090,7 @@ public:
   SplittingDeleteDeactivated splittingDeleteDeactivated() const { return _splittingDeleteDeactivated.actualValue;}
   bool splittingFastRestart() const { return _splittingFastRestart.actualValue; }
   bool splittingBufferedSolver() const { return _splittingBufferedSolver.actualValue; }
+  bool splittingIncrementalModel() const { return _splittingIncrementalModel.actualValue; }
   int splittingFlushPeriod() const { return _splittingFlushPeriod.actualValue; }
   float splittingFlushQuotient() const { return _splittingFlushQuotient.actualValue; }
   bool splittingEagerRemoval() const { return _splittingEagerRemoval.actualValue; }
@@ -2267,7 +2283,10 @@ private:
   ChoiceOptionValue<Demodulation> _forwardDemodulation;
   BoolOptionValue _forwardLiteralRewriting;
   BoolOptionValue _forwardSubsumption;
+  ChoiceOptionValue<SubsumptionIndex> _subsumptionIndex;
   BoolOptionValue _forwardSubsumptionResolution;
+  UnsignedOptionValue _forwardSimplificationBatch;
+  BoolOptionValue _compactSubstitutionTrees;
   ChoiceOptionValue<FunctionDefinitionElimination> _functionDefinitionElimination;
   IntOptionValue _functionNumber;
   
@@ -2287,6 +2306,7 @@ private:
   /** if true, then calling set() on non-existing options will not result in a user error */
   ChoiceOptionValue<IgnoreMissing> _ignoreMissing;
   StringOptionValue _include;
+  StringOptionValue _problemCache;
   /** if this option is true, Vampire will add the numeral weight of a clause
    * to its weight. The weight is defined as the sum of binary sizes of all
    * integers occurring in this clause. This option has not been tested and
@@ -2314,6 +2334,7 @@ private:
   ChoiceOptionValue<MathInductionKind> _mathInduction;
   ChoiceOptionValue<InductionChoice> _inductionChoice;
   UnsignedOptionValue _maxInductionDepth;
+  UnsignedOptionValue _passiveSpillLimit;
   BoolOptionValue _inductionNegOnly;
   BoolOptionValue _inductionUnitOnly;
 
@@ -2338,6 +2359,8 @@ private:
   ChoiceOptionValue<Mode> _mode;
   ChoiceOptionValue<Schedule> _schedule;
   UnsignedOptionValue _multicore;
+  BoolOptionValue _sharedPreprocessing;
+  UnsignedOptionValue _sliceStallTime;
 
   StringOptionValue _namePrefix;
   IntOptionValue _naming;
@@ -2432,6 +2455,7 @@ private:
   ChoiceOptionValue<SplittingDeleteDeactivated> _splittingDeleteDeactivated;
   BoolOptionValue _splittingFastRestart;
   BoolOptionValue _splittingBufferedSolver;
+  BoolOptionValue _splittingIncrementalModel;
 
   ChoiceOptionValue<Statistics> _statistics;
   BoolOptionValue _superpositionFromVariables;
@@ -0,0 +1,639 @@
+
+/*
+ * File ProblemCache.cpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ProblemCache.cpp
+ * Implements class ProblemCache.
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include "Lib/Environment.hpp"
+#include "Lib/Int.hpp"
+#include "Lib/Sys/MappedFile.hpp"
+
+#include "Kernel/Clause.hpp"
+#include "Kernel/Inference.hpp"
+#include "Kernel/Problem.hpp"
+#include "Kernel/SortHelper.hpp"
+#include "Kernel/Sorts.hpp"
+#include "Kernel/Term.hpp"
+#include "Kernel/Unit.hpp"
+
+#include "Options.hpp"
+#include "UIHelper.hpp"
+
+#include "ProblemCache.hpp"
+
+namespace Shell
+{
+
+using namespace Lib::Sys;
+
+/**
+ * Reads words and strings from the mapped cache file.
+ *
+ * Until the header has been verified, a file that ends prematurely only
+ * makes @b ok() return false, as the file may be of a different version.
+ * Afterwards such a file or impossible values are reported as a user error.
+ */
+class ProblemCache::Reader
+{
+public:
+  Reader(const vstring& fileName, const char* data, size_t size)
+  : _fileName(fileName), _pos(data), _end(data+size), _ok(true), _strict(false) {}
+
+  bool ok() const { return _ok; }
+  bool atEnd() const { return _pos==_end; }
+  /** Report all further errors as a corrupted cache */
+  void setStrict() { _strict=true; }
+
+  unsigned readWord()
+  {
+    if(static_cast<size_t>(_end-_pos)<sizeof(unsigned)) {
+      fail();
+      return 0;
+    }
+    unsigned res;
+    memcpy(&res, _pos, sizeof(unsigned));
+    _pos+=sizeof(unsigned);
+    return res;
+  }
+
+  vstring readString()
+  {
+    unsigned len=readWord();
+    if(static_cast<size_t>(_end-_pos)<len) {
+      fail();
+      return "";
+    }
+    vstring res(_pos, len);
+    _pos+=len;
+    return res;
+  }
+
+  /** Read a word that must be less than @b limit */
+  unsigned readBounded(unsigned limit)
+  {
+    unsigned res=readWord();
+    if(res>=limit) {
+      fail();
+      return 0;
+    }
+    return res;
+  }
+
+  void fail()
+  {
+    _ok=false;
+    if(_strict) {
+      corrupted();
+    }
+  }
+
+  void corrupted() NO_RETURN
+  {
+    USER_ERROR("The problem cache "+_fileName+" is corrupted");
+  }
+
+private:
+  vstring _fileName;
+  const char* _pos;
+  const char* _end;
+  bool _ok;
+  bool _strict;
+};
+
+/**
+ * Return the header the cache file for the current input and options must
+ * start with, or the empty string if some input file cannot be read.
+ *
+ * If @b checkInput is false, the header consists of the preprocessing key
+ * only. This is used for files that live only as long as the run that
+ * created them and so cannot come from a different input.
+ */
+vstring ProblemCache::getHeader(bool checkInput)
+{
+  CALL("ProblemCache::getHeader");
+
+  vstring res;
+  writeString(res, env.options->generatePreprocessingKey());
+  if(!checkInput) {
+    return res;
+  }
+
+  StringStack files;
+  files.push(env.options->inputFile());
+  files.loadFromIterator(StringStack::BottomFirstIterator(UIHelper::includedFiles()));
+  writeWord(res, files.size());
+  StringStack::BottomFirstIterator fit(files);
+  while(fit.hasNext()) {
+    vstring file=fit.next();
+    unsigned long long hash;
+    if(!getFileHash(file, hash)) {
+      return "";
+    }
+    writeString(res, file);
+    writeWord(res, static_cast<unsigned>(hash));
+    writeWord(res, static_cast<unsigned>(hash>>32));
+  }
+  return res;
+}
+
+/**
+ * Assign to @b hash the FNV-1a hash of the content of the file @b fileName.
+ * Return false if the file cannot be read.
+ */
+bool ProblemCache::getFileHash(const vstring& fileName, unsigned long long& hash)
+{
+  CALL("ProblemCache::getFileHash");
+
+  MappedFile file(fileName);
+  if(!file.isOpen()) {
+    return false;
+  }
+  hash=14695981039346656037ull;
+  const char* data=file.data();
+  size_t size=file.size();
+  for(size_t i=0;i<size;i++) {
+    hash^=static_cast<unsigned char>(data[i]);
+    hash*=1099511628211ull;
+  }
+  return true;
+}
+
+/**
+ * Return the problem stored in the cache file @b fileName, or 0 if the file
+ * does not exist or was created from a different input (unless
+ * @b checkInput is false) or with different preprocessing options.
+ *
+ * The input files included by the problem are only known after the problem
+ * has been parsed. The cache therefore stores their names, which are used
+ * for computing the header before the problem is parsed.
+ */
+Problem* ProblemCache::load(const vstring& fileName, bool checkInput)
+{
+  CALL("ProblemCache::load");
+
+  MappedFile file(fileName);
+  if(!file.isOpen() || file.size()==0) {
+    return 0;
+  }
+  Reader in(fileName, file.data(), file.size());
+
+  if(in.readWord()!=MAGIC || in.readWord()!=VERSION) {
+    return 0;
+  }
+  //the header is preceded by the names of the included files
+  StringStack& included=UIHelper::includedFiles();
+  included.reset();
+  unsigned includedCnt=in.readWord();
+  for(unsigned i=0;i<includedCnt && in.ok();i++) {
+    included.push(in.readString());
+  }
+  vstring header=in.ok() ? getHeader(checkInput) : "";
+  if(header.empty() || in.readString()!=header) {
+    included.reset();
+    return 0;
+  }
+  in.setStrict();
+
+  UIHelper::setConjecturePresence(in.readWord());
+  bool incomplete=in.readWord();
+  unsigned lastParsingNumber=in.readWord();
+  unsigned lastNumber=in.readWord();
+
+  readSymbols(in, true);
+  readSymbols(in, false);
+
+  Unit::setLastNumber(lastParsingNumber);
+  Unit::onParsingEnd();
+
+  UnitList* units=0;
+  UnitList** tail=&units;
+  unsigned clauseCnt=in.readWord();
+  for(unsigned i=0;i<clauseCnt;i++) {
+    *tail=new UnitList(readClause(in), 0);
+    tail=(*tail)->tailPtr();
+  }
+  if(!in.atEnd()) {
+    in.fail();
+  }
+  Unit::setLastNumber(lastNumber);
+
+  Problem* res=new Problem(units);
+  if(incomplete) {
+    res->reportIncompleteTransformation();
+  }
+  if(env.options->showPreprocessing()) {
+    env.beginOutput();
+    env.out() << "[PP] loaded " << clauseCnt << " clauses from the problem cache " << fileName << std::endl;
+    env.endOutput();
+  }
+  return res;
+}
+
+/**
+ * Add the function (if @b functions is true) or predicate symbols stored
+ * in the cache to the signature. The symbols the signature already has
+ * must be the first stored ones, they only get the stored flags and usage.
+ */
+void ProblemCache::readSymbols(Reader& in, bool functions)
+{
+  CALL("ProblemCache::readSymbols");
+
+  unsigned present=functions ? env.signature->functions() : env.signature->predicates();
+  unsigned cnt=in.readWord();
+  if(cnt<present) {
+    in.corrupted();
+  }
+  //equality is the predicate number zero in every signature
+  for(unsigned i=functions ? 0 : 1;i<cnt;i++) {
+    vstring name=in.readString();
+    unsigned arity=in.readWord();
+    unsigned flags=in.readWord();
+    unsigned usageCnt=in.readWord();
+    unsigned unitUsageCnt=in.readWord();
+
+    bool added;
+    unsigned num=functions ? env.signature->addFunction(name, arity, added)
+	: env.signature->addPredicate(name, arity, added);
+    if(num!=i || added==(i<present)) {
+      in.corrupted();
+    }
+    Signature::Symbol* sym=functions ? env.signature->getFunction(num) : env.signature->getPredicate(num);
+    if(flags & SF_INTRODUCED) { sym->markIntroduced(); }
+    if(flags & SF_SKOLEM) { sym->markSkolem(); }
+    if(flags & SF_PROTECTED) { sym->markProtected(); }
+    if(flags & SF_SKIP) { sym->markSkip(); }
+    if(flags & SF_LABEL) { sym->markLabel(); }
+    if(flags & SF_EQUALITY_PROXY) { sym->markEqualityProxy(); }
+    if(flags & SF_IN_GOAL) { sym->markInGoal(); }
+    if(flags & SF_IN_UNIT) { sym->markInUnit(); }
+    for(unsigned j=sym->usageCnt();j<usageCnt;j++) {
+      sym->incUsageCnt();
+    }
+    for(unsigned j=sym->unitUsageCnt();j<unitUsageCnt;j++) {
+      sym->incUnitUsageCnt();
+    }
+  }
+}
+
+Clause* ProblemCache::readClause(Reader& in)
+{
+  CALL("ProblemCache::readClause");
+
+  unsigned number=in.readWord();
+  Unit::InputType inputType=static_cast<Unit::InputType>(in.readBounded(Unit::MODEL_DEFINITION+1));
+  bool included=in.readWord();
+  unsigned len=in.readWord();
+
+  static Stack<Literal*> lits;
+  lits.reset();
+  static Stack<TermList> args;
+  for(unsigned i=0;i<len;i++) {
+    unsigned pred=in.readBounded(env.signature->predicates());
+    bool polarity=in.readWord();
+    if(pred==0) {
+      unsigned sort=in.readBounded(env.sorts->count());
+      TermList lhs=readTerm(in);
+      TermList rhs=readTerm(in);
+      lits.push(Literal::createEquality(polarity, lhs, rhs, sort));
+      continue;
+    }
+    unsigned arity=env.signature->predicateArity(pred);
+    args.reset();
+    for(unsigned j=0;j<arity;j++) {
+      args.push(readTerm(in));
+    }
+    lits.push(Literal::create(pred, arity, polarity, false, args.begin()));
+  }
+
+  //the clause gets the number it had when the cache was created
+  Unit::setLastNumber(number-1);
+  Clause* res=Clause::fromStack(lits, inputType, new Inference(Inference::PROBLEM_CACHE));
+  if(included) {
+    res->markIncluded();
+  }
+  return res;
+}
+
+/**
+ * Read a term written in prefix order by writeClause
+ */
+TermList ProblemCache::readTerm(Reader& in)
+{
+  CALL("ProblemCache::readTerm");
+
+  //functors of the terms being read and the positions of their arguments in args
+  static Stack<pair<unsigned,size_t> > frames;
+  static Stack<TermList> args;
+  frames.reset();
+  args.reset();
+
+  for(;;) {
+    unsigned w=in.readWord();
+    TermList t;
+    if(w & VAR_FLAG) {
+      t=TermList(w & ~VAR_FLAG, false);
+    }
+    else {
+      if(w>=env.signature->functions()) {
+	in.corrupted();
+      }
+      if(env.signature->functionArity(w)) {
+	frames.push(make_pair(w, args.size()));
+	continue;
+      }
+      t=TermList(Term::createConstant(w));
+    }
+    //complete the terms whose last argument has been read
+    for(;;) {
+      if(frames.isEmpty()) {
+	return t;
+      }
+      args.push(t);
+      unsigned fn=frames.top().first;
+      size_t base=frames.top().second;
+      unsigned arity=env.signature->functionArity(fn);
+      if(args.size()-base<arity) {
+	break;
+      }
+      frames.pop();
+      t=TermList(Term::create(fn, arity, args.begin()+base));
+      args.truncate(base);
+    }
+  }
+}
+
+/**
+ * Store the preprocessed problem @b prb into the cache file @b fileName,
+ * if the problem can be cached. If @b checkInput is false, loading the file
+ * does not check that the input files are unchanged.
+ */
+void ProblemCache::save(const vstring& fileName, Problem& prb, bool checkInput)
+{
+  CALL("ProblemCache::save");
+
+  if(!canSave(prb)) {
+    if(env.options->showPreprocessing()) {
+      env.beginOutput();
+      env.out() << "[PP] the problem cannot be stored in the problem cache" << std::endl;
+      env.endOutput();
+    }
+    return;
+  }
+  vstring header=getHeader(checkInput);
+  if(header.empty()) {
+    return;
+  }
+
+  vstring out;
+  writeWord(out, MAGIC);
+  writeWord(out, VERSION);
+  const StringStack& included=UIHelper::includedFiles();
+  writeWord(out, included.size());
+  StringStack::BottomFirstIterator iit(included);
+  while(iit.hasNext()) {
+    writeString(out, iit.next());
+  }
+  writeString(out, header);
+
+  writeWord(out, UIHelper::haveConjecture());
+  writeWord(out, prb.hadIncompleteTransformation());
+  writeWord(out, Unit::getLastParsingNumber());
+  writeWord(out, Unit::getLastNumber());
+
+  unsigned funs=env.signature->functions();
+  writeWord(out, funs);
+  for(unsigned i=0;i<funs;i++) {
+    writeSymbol(out, env.signature->getFunction(i));
+  }
+  unsigned preds=env.signature->predicates();
+  writeWord(out, preds);
+  for(unsigned i=1;i<preds;i++) {
+    writeSymbol(out, env.signature->getPredicate(i));
+  }
+
+  writeWord(out, UnitList::length(prb.units()));
+  UnitList::Iterator uit(prb.units());
+  while(uit.hasNext()) {
+    writeClause(out, uit.next()->asClause());
+  }
+
+  //write to a fresh temporary file first, so that a concurrent run never
+  //sees an incomplete cache; mkstemp never opens an existing file (or a
+  //symbolic link planted in its place)
+  vstring tmpName=fileName+".XXXXXX";
+  int fd=mkstemp(&tmpName[0]);
+  FILE* f=fd==-1 ? 0 : fdopen(fd, "wb");
+  if(!f) {
+    int err=errno;
+    if(fd!=-1) {
+      close(fd);
+      remove(tmpName.c_str());
+    }
+    SYSTEM_FAIL("Cannot create the problem cache "+tmpName, err);
+  }
+  bool ok=fwrite(out.data(), 1, out.size(), f)==out.size();
+  ok=fclose(f)==0 && ok;
+  if(!ok || rename(tmpName.c_str(), fileName.c_str())!=0) {
+    int err=errno;
+    remove(tmpName.c_str());
+    SYSTEM_FAIL("Cannot write the problem cache "+fileName, err);
+  }
+}
+
+/**
+ * Return true if the problem and the current signature contain only
+ * what the cache format can represent
+ */
+bool ProblemCache::canSave(Problem& prb)
+{
+  CALL("ProblemCache::canSave");
+
+  //the eliminated and trivial predicates recorded in the problem are only
+  //needed for printing models found by these algorithms
+  Options::SaturationAlgorithm alg=env.options->saturationAlgorithm();
+  if(alg==Options::SaturationAlgorithm::FINITE_MODEL_BUILDING ||
+     alg==Options::SaturationAlgorithm::INST_GEN) {
+    return false;
+  }
+  if(env.colorUsed || env.sorts->count()!=Sorts::FIRST_USER_SORT ||
+     env.signature->hasTermAlgebras() || env.signature->hasDistinctGroups()) {
+    return false;
+  }
+
+  unsigned funs=env.signature->functions();
+  for(unsigned i=0;i<funs;i++) {
+    if(!canSaveSymbol(env.signature->getFunction(i), true)) {
+      return false;
+    }
+  }
+  unsigned preds=env.signature->predicates();
+  for(unsigned i=1;i<preds;i++) {
+    if(!canSaveSymbol(env.signature->getPredicate(i), false)) {
+      return false;
+    }
+  }
+
+  UnitList::Iterator uit(prb.units());
+  while(uit.hasNext()) {
+    Unit* u=uit.next();
+    if(!u->isClause()) {
+      return false;
+    }
+    Clause* cl=u->asClause();
+    for(unsigned i=0;i<cl->length();i++) {
+      Literal* lit=(*cl)[i];
+      if(lit->isEquality() && SortHelper::getEqualityArgumentSort(lit)!=Sorts::SRT_DEFAULT) {
+	return false;
+      }
+      if(!canSaveTerm(lit)) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool ProblemCache::canSaveSymbol(Signature::Symbol* sym, bool function)
+{
+  CALL("ProblemCache::canSaveSymbol");
+
+  if(sym->interpreted() || sym->stringConstant() || sym->numericConstant() ||
+     sym->overflownConstant() || sym->answerPredicate() || sym->termAlgebraCons() ||
+     sym->color()!=COLOR_TRANSPARENT) {
+    return false;
+  }
+  OperatorType* type=function ? sym->fnType() : sym->predType();
+  return type->isAllDefault();
+}
+
+/**
+ * Return true if the term @b t contains no special terms or variables
+ */
+bool ProblemCache::canSaveTerm(Term* t)
+{
+  CALL("ProblemCache::canSaveTerm");
+
+  if(t->isSpecial()) {
+    return false;
+  }
+  static Stack<const TermList*> toDo;
+  toDo.reset();
+  toDo.push(t->args());
+  while(toDo.isNonEmpty()) {
+    const TermList* ts=toDo.pop();
+    if(ts->isEmpty()) {
+      continue;
+    }
+    toDo.push(ts->next());
+    if(ts->isSpecialVar() || (ts->isTerm() && ts->term()->isSpecial())) {
+      return false;
+    }
+    if(ts->isTerm()) {
+      toDo.push(ts->term()->args());
+    }
+  }
+  return true;
+}
+
+void ProblemCache::writeWord(vstring& out, unsigned w)
+{
+  out.append(reinterpret_cast<const char*>(&w), sizeof(unsigned));
+}
+
+void ProblemCache::writeString(vstring& out, const vstring& str)
+{
+  writeWord(out, str.size());
+  out.append(str);
+}
+
+void ProblemCache::writeSymbol(vstring& out, Signature::Symbol* sym)
+{
+  CALL("ProblemCache::writeSymbol");
+
+  //the signature quotes the names that need it when the symbol is created,
+  //so the name is stored as it was added
+  vstring name=sym->name();
+  if(name.size()>1 && name[0]=='\'') {
+    name=name.substr(1, name.size()-2);
+  }
+  writeString(out, name);
+  writeWord(out, sym->arity());
+  unsigned flags=0;
+  if(sym->introduced()) { flags|=SF_INTRODUCED; }
+  if(sym->skolem()) { flags|=SF_SKOLEM; }
+  if(sym->protectedSymbol()) { flags|=SF_PROTECTED; }
+  if(sym->skip()) { flags|=SF_SKIP; }
+  if(sym->label()) { flags|=SF_LABEL; }
+  if(sym->equalityProxy()) { flags|=SF_EQUALITY_PROXY; }
+  if(sym->inGoal()) { flags|=SF_IN_GOAL; }
+  if(sym->inUnit()) { flags|=SF_IN_UNIT; }
+  writeWord(out, flags);
+  writeWord(out, sym->usageCnt());
+  writeWord(out, sym->unitUsageCnt());
+}
+
+/**
+ * Write the clause @b cl, the arguments of its literals are written in
+ * prefix order as variable numbers with VAR_FLAG and function numbers
+ */
+void ProblemCache::writeClause(vstring& out, Clause* cl)
+{
+  CALL("ProblemCache::writeClause");
+
+  writeWord(out, cl->number());
+  writeWord(out, cl->inputType());
+  writeWord(out, cl->included());
+  writeWord(out, cl->length());
+
+  static Stack<const TermList*> toDo;
+  for(unsigned i=0;i<cl->length();i++) {
+    Literal* lit=(*cl)[i];
+    writeWord(out, lit->functor());
+    writeWord(out, lit->polarity());
+    if(lit->isEquality()) {
+      writeWord(out, SortHelper::getEqualityArgumentSort(lit));
+    }
+    toDo.reset();
+    toDo.push(lit->args());
+    while(toDo.isNonEmpty()) {
+      const TermList* ts=toDo.pop();
+      if(ts->isEmpty()) {
+	continue;
+      }
+      toDo.push(ts->next());
+      if(ts->isVar()) {
+	ASS_L(ts->var(), VAR_FLAG);
+	writeWord(out, ts->var() | VAR_FLAG);
+      }
+      else {
+	writeWord(out, ts->term()->functor());
+	toDo.push(ts->term()->args());
+      }
+    }
+  }
+}
+
+}
@@ -0,0 +1,107 @@
+
+/*
+ * File ProblemCache.hpp.
+ *
+ * This file is part of the source code of the software program
+ * Vampire. It is protected by applicable
+ * copyright laws.
+ *
+ * This source code is distributed under the licence found here
+ * https://vprover.github.io/license.html
+ * and in the source directory
+ *
+ * In summary, you are allowed to use Vampire for non-commercial
+ * purposes but not allowed to distribute, modify, copy, create derivatives,
+ * or use in competitions. 
+ * For other uses of Vampire please contact developers for a different
+ * licence, which we will make an effort to provide. 
+ */
+/**
+ * @file ProblemCache.hpp
+ * Defines class ProblemCache.
+ */
+
+#ifndef __ProblemCache__
+#define __ProblemCache__
+
+#include "Forwards.hpp"
+
+#include "Lib/VString.hpp"
+
+#include "Kernel/Signature.hpp"
+
+namespace Shell {
+
+using namespace Lib;
+using namespace Kernel;
+
+/**
+ * Stores the preprocessed problem in a binary file, from which later runs
+ * on the same input with the same preprocessing options load it instead
+ * of parsing and preprocessing the input.
+ *
+ * The file starts with a header holding a hash of the input file and of
+ * every included file together with the preprocessing key of the options
+ * (see Options::generatePreprocessingKey). The rest of the file holds the
+ * symbols of the signature and the clauses, whose terms are given by
+ * symbol and variable numbers in prefix order. Symbols are added to the
+ * signature in the original order and clauses get their original numbers,
+ * so that the proof search is the same as on the input itself. Loaded
+ * clauses carry the Inference::PROBLEM_CACHE rule, so proofs start from
+ * them rather than from the input formulas. The
+ * signature must be fresh or contain exactly the symbols the signature had
+ * when its first symbols were stored, as in the processes of the portfolio
+ * mode that all start from the same parsed problem.
+ *
+ * Only problems whose preprocessing produced clauses over uninterpreted
+ * symbols of the default sort are cached. Other problems are always parsed.
+ */
+class ProblemCache
+{
+public:
+  static Problem* load(const vstring& fileName, bool checkInput=true);
+  static void save(const vstring& fileName, Problem& prb, bool checkInput=true);
+
+private:
+  enum {
+    /** First word of every cache file, the bytes "VBIN" on little endian machines */
+    MAGIC = 0x4e494256,
+    /** Number of the format version, to be increased when the format changes */
+    VERSION = 2,
+    /** Flag distinguishing variables from symbols in the term words */
+    VAR_FLAG = 0x80000000u
+  };
+
+  /** Flags of symbols stored in the cache */
+  enum SymbolFlags {
+    SF_INTRODUCED = 1,
+    SF_SKOLEM = 2,
+    SF_PROTECTED = 4,
+    SF_SKIP = 8,
+    SF_LABEL = 16,
+    SF_EQUALITY_PROXY = 32,
+    SF_IN_GOAL = 64,
+    SF_IN_UNIT = 128
+  };
+
+  class Reader;
+
+  static vstring getHeader(bool checkInput);
+  static bool getFileHash(const vstring& fileName, unsigned long long& hash);
+  static bool canSave(Problem& prb);
+  static bool canSaveSymbol(Signature::Symbol* sym, bool function);
+  static bool canSaveTerm(Term* t);
+
+  static void writeWord(vstring& out, unsigned w);
+  static void writeString(vstring& out, const vstring& str);
+  static void writeSymbol(vstring& out, Signature::Symbol* sym);
+  static void writeClause(vstring& out, Clause* cl);
+
+  static void readSymbols(Reader& in, bool functions);
+  static Clause* readClause(Reader& in);
+  static TermList readTerm(Reader& in);
+};
+
+}
+
+#endif // __ProblemCache__
@@ -21,6 +21,7 @@
  * Implements class SineUtils.
  */
 
+#include <algorithm>
 #include <cmath>
 
 #include "Lib/Deque.hpp"
@@ -528,49 +529,76 @@ if(env.clausePriorities){
 //////////////////////////////////////
 
 SineTheorySelector::SineTheorySelector(const Options& opt)
-: _genThreshold(opt.sineGeneralityThreshold()), _opt(opt)
+: _genThreshold(opt.sineGeneralityThreshold()), _allAxioms(true), _allIncluded(true)
 {
   CALL("SineTheorySelector::SineTheorySelector");
 }
 
-void SineTheorySelector::handlePossibleSignatureChange()
+SineTheorySelector::~SineTheorySelector()
 {
-  CALL("SineTheorySelector::handlePossibleSignatureChange");
+  CALL("SineTheorySelector::~SineTheorySelector");
 
-  size_t symIdBound=_symExtr.getSymIdBound();
-  size_t oldSize=_def.size();
-  ASS_EQ(_gen.size(), oldSize);
+  for (size_t i=0;i<_def.size();i++) {
+    DEntryList::destroy(_def[i]);
+  }
+}
 
-  if (symIdBound==oldSize) {
-    return;
+/**
+ * Return generality of symbol @b s, i.e. the number of theory axioms it
+ * occurs in plus the number stored in @b localGen
+ *
+ * Symbols introduced after the selection structure was built do not occur
+ * in any theory axiom.
+ */
+unsigned SineTheorySelector::getGenerality(SymId s, DHMap<SymId,unsigned>& localGen)
+{
+  CALL("SineTheorySelector::getGenerality");
+
+  unsigned res=0;
+  localGen.find(s, res);
+  if (s<_gen.size()) {
+    res+=_gen[s];
   }
-  ASS_G(symIdBound, oldSize);
+  return res;
+}
+
+/**
+ * Return the generality of the least general symbol of unit @b u, taking
+ * @b localGen into account. Results are stored in @b cache.
+ */
+unsigned SineTheorySelector::getLeastGenerality(Unit* u, DHMap<SymId,unsigned>& localGen, DHMap<Unit*,unsigned>& cache)
+{
+  CALL("SineTheorySelector::getLeastGenerality");
 
-  _gen.expand(symIdBound);
-  _def.expand(symIdBound);
-  for (size_t i=oldSize;i<symIdBound;i++) {
-    _gen[i]=0;
-    _def[i]=0;
+  unsigned* pres;
+  if (!cache.getValuePtr(u, pres)) {
+    return *pres;
   }
+  *pres=UINT_MAX;
+  SymIdIterator sit=_symExtr.extractSymIds(u);
+  while (sit.hasNext()) {
+    *pres=min(*pres, getGenerality(sit.next(), localGen));
+  }
+  return *pres;
 }
 
 /**
- * Connect unit @b u with symbols it defines
+ * Connect unit @b u with all its symbols. If @b localDef is zero,
+ * the unit is added into the selection structure, otherwise into
+ * @b localDef. Return false if the unit does not contain any symbols.
+ *
+ * The connections are not filtered here, as the problem formulas
+ * can change the generality of the symbols of a theory axiom. Whether
+ * a connection is used is decided at the time of selection.
  */
-void SineTheorySelector::updateDefRelation(Unit* u)
+bool SineTheorySelector::updateDefRelation(Unit* u, DHMap<SymId,unsigned>& localGen, DHMap<SymId,DEntryList*>* localDef)
 {
   CALL("SineTheorySelector::updateDefRelation");
 
   SymIdIterator sit0=_symExtr.extractSymIds(u);
 
   if (!sit0.hasNext()) {
-
-    if(env.clausePriorities){
-      env.clausePriorities->insert(u,1);
-    }
-
-    _unitsWithoutSymbols.push(u);
-    return;
+    return false;
   }
 
   static Stack<SymId> symIds;
@@ -580,11 +608,11 @@ void SineTheorySelector::updateDefRelation(Unit* u)
   Stack<SymId>::Iterator sit(symIds);
 
   ALWAYS(sit.hasNext());
-  unsigned leastGenVal=_gen[sit.next()];
+  unsigned leastGenVal=getGenerality(sit.next(), localGen);
 
   while (sit.hasNext()) {
     SymId sym=sit.next();
-    unsigned val=_gen[sym];
+    unsigned val=getGenerality(sym, localGen);
     ASS_G(val,0);
 
     if (val<leastGenVal) {
@@ -592,34 +620,38 @@ void SineTheorySelector::updateDefRelation(Unit* u)
     }
   }
 
-  unsigned generalityLimit=leastGenVal*(maxTolerance/strictTolerance);
-
   Stack<SymId>::Iterator sit2(symIds);
   while (sit2.hasNext()) {
     SymId sym=sit2.next();
-    unsigned val=_gen[sym];
-
-    if (val<=_genThreshold) {
-      //if a symbol fits under _genThreshold, add it into the relation
-      DEntryList::push(DEntry(strictTolerance,u),_def[sym]);
+    if (localDef) {
+      DEntryList** pdef;
+      localDef->getValuePtr(sym, pdef, 0);
+      DEntryList::push(DEntry(leastGenVal,u),*pdef);
     }
-    else if (val<=generalityLimit) {
-      unsigned short minTolerance=(val*strictTolerance)/leastGenVal;
-      //only if the symbol is over _genThreshold; otherwise it is already added
-      DEntryList::push(DEntry(minTolerance,u),_def[sym]);
+    else {
+      DEntryList::push(DEntry(leastGenVal,u),_def[sym]);
     }
   }
-
+  return true;
 }
 
+/**
+ * Orders entries by increasing least generality, keeping the order of
+ * units with the same least generality
+ */
+struct SineTheorySelector::LeastGenLess
+{
+  bool operator()(const DEntry& e1, const DEntry& e2) const
+  { return e1.leastGen<e2.leastGen; }
+};
+
 /**
  * Preprocess the theory axioms in @b units, so that some of them can be later
- * selected for a particular problem formulas by the @b addSelectedAxioms() function
+ * selected for a particular problem by the @b perform() function
  *
- * If the value of the sineTolerance and sineDepth options changes after the
- * preprocessing and before the call to the @b addSelectedAxioms function, the
- * modified values will be used (The preprocessing allows for selection with
- * tolerance values up to the limit implied by the value of @b maxTolerance.)
+ * The selection structure allows for selection with any tolerance of at
+ * least 1, any depth limit and the generality threshold given by the
+ * options passed to the constructor.
  */
 void SineTheorySelector::initSelectionStructure(UnitList* units)
 {
@@ -631,62 +663,144 @@ void SineTheorySelector::initSelectionStructure(UnitList* units)
 
   SymId symIdBound=_symExtr.getSymIdBound();
 
-  //build the D-relation
-  _def.init(symIdBound,0);
+  //build the D-relation, adding the units by increasing least generality,
+  //so that every list of _def is ordered by decreasing least generality
+  DHMap<SymId,unsigned> noLocalGen;
+  DHMap<Unit*,unsigned> leastGenCache;
+  Stack<DEntry> byLeastGen;
   UnitList::Iterator uit(units);
   while (uit.hasNext()) {
     Unit* u=uit.next();
-    updateDefRelation(u);
+    ALWAYS(_theoryUnits.insert(u));
+    _allAxioms&=u->inputType()==Unit::AXIOM;
+    _allIncluded&=u->included();
+    byLeastGen.push(DEntry(getLeastGenerality(u, noLocalGen, leastGenCache), u));
+  }
+  std::stable_sort(byLeastGen.begin(), byLeastGen.end(), LeastGenLess());
+
+  _def.init(symIdBound,0);
+  Stack<DEntry>::BottomFirstIterator eit(byLeastGen);
+  while (eit.hasNext()) {
+    Unit* u=eit.next().unit;
+    if (!updateDefRelation(u, noLocalGen, 0)) {
+      _unitsWithoutSymbols.push(u);
+    }
   }
 }
 
+/**
+ * Return true if the selection structure can be used for the SInE
+ * selection specified by the options @b opt
+ *
+ * The theory axioms must all be selected over (rather than selected from)
+ * and the selection must not assign clause priorities.
+ */
+bool SineTheorySelector::canPerform(const Options& opt)
+{
+  CALL("SineTheorySelector::canPerform");
 
-void SineTheorySelector::perform(UnitList*& units)
+  switch (opt.sineSelection()) {
+  case Options::SineSelection::AXIOMS:
+    if (!_allAxioms) {
+      return false;
+    }
+    break;
+  case Options::SineSelection::INCLUDED:
+    if (!_allIncluded) {
+      return false;
+    }
+    break;
+  default:
+    return false;
+  }
+  return !env.clausePriorities && opt.sineGeneralityThreshold()==_genThreshold
+      && opt.sineTolerance()>=1.0f;
+}
+
+void SineTheorySelector::perform(Problem& prb, const Options& opt)
 {
   CALL("SineTheorySelector::perform");
 
+  if (perform(prb.units(), opt)) {
+    prb.reportIncompleteTransformation();
+  }
+  prb.invalidateByRemoval();
+}
+
+/**
+ * Perform the SInE selection on @b units, which consist of the theory
+ * axioms in the selection structure and of the problem formulas
+ *
+ * The theory axioms are not traversed, they are only reached from the
+ * symbols of the problem formulas. The problem axioms (or included
+ * formulas) are connected with their symbols in a local D-relation, in
+ * which the generality counts the problem formulas as well.
+ */
+bool SineTheorySelector::perform(UnitList*& units, const Options& opt)
+{
+  CALL("SineTheorySelector::perform");
+  ASS(canPerform(opt));
+
   TimeCounter tc(TC_SINE_SELECTION);
 
-  handlePossibleSignatureChange();
+  bool onIncluded=opt.sineSelection()==Options::SineSelection::INCLUDED;
+  float tolerance=opt.sineTolerance();
+  unsigned depthLimit=opt.sineDepth();
 
+  unsigned theoryUnitCnt=0;
+  static Stack<Unit*> problemUnits;
+  problemUnits.reset();
   UnitList::Iterator uit(units);
   while (uit.hasNext()) {
     Unit* u=uit.next();
-    SymIdIterator sit=_symExtr.extractSymIds(u);
+    if (_theoryUnits.find(u)) {
+      theoryUnitCnt++;
+    }
+    else {
+      problemUnits.push(u);
+    }
+  }
+  ASS_EQ(theoryUnitCnt, _theoryUnits.size());
+
+  //count the symbol occurrences in the problem formulas
+  DHMap<SymId,unsigned> localGen;
+  Stack<Unit*>::Iterator puit(problemUnits);
+  while (puit.hasNext()) {
+    SymIdIterator sit=_symExtr.extractSymIds(puit.next());
     while (sit.hasNext()) {
-      SymId sid=sit.next();
-      _gen[sid]++;
+      unsigned* pgen;
+      localGen.getValuePtr(sit.next(), pgen, 0);
+      (*pgen)++;
     }
   }
 
-  UnitList* res=0;
+  DHMap<SymId,DEntryList*> localDef;
+  DHMap<Unit*,unsigned> leastGenCache;
+  Stack<Unit*> unitsWithoutSymbols;
   DHSet<SymId> addedSymIds;
   DHSet<Unit*> selected;
+  Stack<Unit*> selectedStack; //on this stack there are Units in the order they were selected
   Deque<Unit*> newlySelected;
 
-  bool sineOnIncluded=_opt.sineSelection()==Options::SineSelection::INCLUDED;
-
-  //build the D-relation and select the non-axiom formulas
-  UnitList::Iterator uit2(units);
-  while (uit2.hasNext()) {
-    Unit* u=uit2.next();
-    bool performSelection= sineOnIncluded ? u->included() : ((u->inputType()==Unit::AXIOM)
-                   || (env.options->guessTheGoal() != Options::GoalGuess::OFF && u->inputType()==Unit::ASSUMPTION));
+  //build the local D-relation and select the non-axiom formulas
+  Stack<Unit*>::Iterator puit2(problemUnits);
+  while (puit2.hasNext()) {
+    Unit* u=puit2.next();
+    bool performSelection= onIncluded ? u->included() : ((u->inputType()==Unit::AXIOM)
+                   || (opt.guessTheGoal() != Options::GoalGuess::OFF && u->inputType()==Unit::ASSUMPTION));
 
     if (performSelection) {
-      updateDefRelation(u);
+      if (!updateDefRelation(u, localGen, &localDef)) {
+        unitsWithoutSymbols.push(u);
+      }
     }
     else {
       selected.insert(u);
+      selectedStack.push(u);
       newlySelected.push_back(u);
-      UnitList::push(u,res);
     }
   }
 
-
-  unsigned short intTolerance=static_cast<unsigned short>(ceil(_opt.sineTolerance()*10));
-
-  unsigned depthLimit=_opt.sineDepth();
   unsigned depth=0;
   newlySelected.push_back(0);
 
@@ -716,27 +830,56 @@ void SineTheorySelector::perform(UnitList*& units)
 	//we already added units belonging to this symbol
 	continue;
       }
-      DEntryList::Iterator defUnits(_def[sym]);
-      while (defUnits.hasNext()) {
-	DEntry de=defUnits.next();
-
-	if (de.minTolerance>intTolerance || !selected.insert(de.unit)) {
-	  continue;
+      unsigned val=getGenerality(sym, localGen);
+      DEntryList* localEntries=0;
+      localDef.find(sym, localEntries);
+      for (unsigned i=0;i<2;i++) {
+	DEntryList::Iterator defUnits(i ? localEntries : (sym<_def.size() ? _def[sym] : 0));
+	while (defUnits.hasNext()) {
+	  DEntry de=defUnits.next();
+	  if (selected.find(de.unit)) {
+	    continue;
+	  }
+	  if (val>_genThreshold && val>static_cast<unsigned>(de.leastGen*tolerance)) {
+	    if (i) {
+	      continue;
+	    }
+	    //The least generality of a theory axiom was computed without the problem
+	    //formulas, these can increase it by at most the number of problem units.
+	    //The theory axioms of a symbol are ordered by decreasing least generality,
+	    //so none of the remaining ones can be connected with the symbol either.
+	    if (val>static_cast<unsigned>((de.leastGen+problemUnits.size())*tolerance)) {
+	      break;
+	    }
+	    if (val>static_cast<unsigned>(getLeastGenerality(de.unit, localGen, leastGenCache)*tolerance)) {
+	      continue;
+	    }
+	  }
+	  selected.insert(de.unit);
+	  selectedStack.push(de.unit);
+	  newlySelected.push_back(de.unit);
 	}
-	UnitList::push(de.unit,res);
-	newlySelected.push_back(de.unit);
       }
     }
   }
 
-  UnitList::pushFromIterator(Stack<Unit*>::Iterator(_unitsWithoutSymbols), res);
-
-  UnitList::destroy(units);
-//  units=res->reverse(); //we want to resemble the original SInE as much as possible
-  units=res;
+  DHMap<SymId,DEntryList*>::Iterator ldit(localDef);
+  while (ldit.hasNext()) {
+    DEntryList::destroy(ldit.next());
+  }
 
   env.statistics->sineIterations=depth;
-  env.statistics->selectedBySine=_unitsWithoutSymbols.size() + selected.size();
+  env.statistics->selectedBySine=_unitsWithoutSymbols.size() + unitsWithoutSymbols.size() + selectedStack.size();
+
+  unsigned numberUnitsLeftOut=theoryUnitCnt + problemUnits.size() - env.statistics->selectedBySine;
+
+  UnitList::destroy(units);
+  units=0;
+  UnitList::pushFromIterator(Stack<Unit*>::Iterator(_unitsWithoutSymbols), units);
+  UnitList::pushFromIterator(Stack<Unit*>::Iterator(unitsWithoutSymbols), units);
+  while (selectedStack.isNonEmpty()) {
+    UnitList::push(selectedStack.pop(), units);
+  }
 
 #if SINE_PRINT_SELECTED
   UnitList::Iterator selIt(units);
@@ -744,6 +887,8 @@ void SineTheorySelector::perform(UnitList*& units)
     cout<<'#'<<selIt.next()->toString()<<endl;
   }
 #endif
+
+  return (numberUnitsLeftOut > 0);
 }
 
 }
@@ -27,6 +27,8 @@
 #include "Forwards.hpp"
 
 #include "Lib/DArray.hpp"
+#include "Lib/DHMap.hpp"
+#include "Lib/DHSet.hpp"
 #include "Lib/Stack.hpp"
 
 namespace Shell {
@@ -107,52 +109,70 @@ private:
  * sharing the same set of theory axioms
  *
  * First init the selection structure by @b initSelectionStructure() and
- * then select axioms for a particular problem by @b addSelectedAxioms()
+ * then select axioms for a particular problem by @b perform(). The
+ * structure is not modified by the selection, so it can be built once
+ * (e.g. before forking processes for individual problems) and then used
+ * for any number of problems. The selection for a problem only looks at
+ * the symbols of the theory axioms it reaches from the problem formulas.
+ *
+ * The structure is built with the generality of symbols in the theory
+ * axioms only. The problem formulas are counted in when a theory axiom is
+ * reached, so the result is the same as of @b SineSelector run on the whole
+ * problem.
  */
 class SineTheorySelector
 : public SineBase
 {
 public:
+  CLASS_NAME(SineTheorySelector);
+  USE_ALLOCATOR(SineTheorySelector);
+
   SineTheorySelector(const Options& opt);
+  ~SineTheorySelector();
 
   void initSelectionStructure(UnitList* units);
-  void perform(UnitList*& units);
+  bool canPerform(const Options& opt);
+  bool perform(UnitList*& units, const Options& opt); // returns true iff removed something
+  void perform(Problem& prb, const Options& opt);
 private:
 
-  /** The integer tolerance value is the float option value multiplied by 10 and
-   * truncated
-   *
-   * Therefore, if the @b maxTolerance member is equal to 50, the maximum supported
-   * tolerance is 5. */
-  static const unsigned short maxTolerance=50;
-  static const unsigned short strictTolerance=10;
-
-  void handlePossibleSignatureChange();
-
-  void updateDefRelation(Unit* u);
-
-  unsigned _genThreshold;
-
   struct DEntry
   {
-    DEntry(unsigned short minTolerance, Unit* unit) : minTolerance(minTolerance), unit(unit) {}
+    DEntry(unsigned leastGen, Unit* unit) : leastGen(leastGen), unit(unit) {}
 
-    unsigned short minTolerance;
+    /** Generality of the least general symbol of the unit */
+    unsigned leastGen;
     Unit* unit;
   };
   typedef List<DEntry> DEntryList;
+  struct LeastGenLess;
 
-  /** Stored the D-relation */
+  unsigned getGenerality(SymId s, DHMap<SymId,unsigned>& localGen);
+  unsigned getLeastGenerality(Unit* u, DHMap<SymId,unsigned>& localGen, DHMap<Unit*,unsigned>& cache);
+  bool updateDefRelation(Unit* u, DHMap<SymId,unsigned>& localGen, DHMap<SymId,DEntryList*>* localDef);
+
+  unsigned _genThreshold;
+
+  /** True iff all units in the selection structure are axioms */
+  bool _allAxioms;
+  /** True iff all units in the selection structure are included */
+  bool _allIncluded;
+
+  /**
+   * Stored the D-relation, connecting every symbol with all theory axioms
+   * it occurs in, ordered by decreasing least generality
+   */
   DArray<DEntryList*> _def;
 
+  /** Units in the selection structure */
+  DHSet<Unit*> _theoryUnits;
+
   /**
    * Stored formulas that don't contain any symbols
    *
    * These formulas are always selected.
    */
   Stack<Unit*> _unitsWithoutSymbols;
-
-  const Options& _opt;
 };
 
 
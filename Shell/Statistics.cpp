@@ -103,6 +103,8 @@ Statistics::Statistics()
     interpretedSimplifications(0),
     innerRewrites(0),
     innerRewritesToEqTaut(0),
+    orderingCacheHits(0),
+    orderingCacheMisses(0),
     deepEquationalTautologies(0),
     simpleTautologies(0),
     equationalTautologies(0),
@@ -361,6 +363,11 @@ void Statistics::print(ostream& out)
   SEPARATOR;
 
 
+  HEADING("Term ordering",orderingCacheHits+orderingCacheMisses);
+  COND_OUT("Comparison cache hits", orderingCacheHits);
+  COND_OUT("Comparison cache misses", orderingCacheMisses);
+  SEPARATOR;
+
   //TODO record statistics for MiniSAT
   HEADING("SAT Solver Statistics",satTWLClauseCount+satTWLVariablesCount+
         satTWLSATCalls+satClauses+unitSatClauses+binarySatClauses+
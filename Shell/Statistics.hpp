@@ -169,6 +169,10 @@ public:
   unsigned innerRewrites;
   /** number of inner rewrites into equational tautologies */
   unsigned innerRewritesToEqTaut;
+  /** number of ordering comparisons answered by the comparison cache */
+  unsigned orderingCacheHits;
+  /** number of ordering comparisons not found in the comparison cache */
+  unsigned orderingCacheMisses;
   /** number of equational tautologies discovered by CC */
   unsigned deepEquationalTautologies;
 
@@ -194,6 +194,35 @@ void UIHelper::outputSaturatedSet(ostream& out, UnitIterator uit)
 
 UnitList* parsedUnits;
 
+/**
+ * Parse the input of @b parser and return the parsed units
+ */
+UnitList* UIHelper::parseTPTP(Parse::TPTP& parser)
+{
+  CALL("UIHelper::parseTPTP");
+
+  try{
+    parser.parse();
+  }
+  catch (UserErrorException& exception) {
+    vstring msg = exception.msg();
+    throw Parse::TPTP::ParseErrorException(msg,parser.lineNumber());
+  }
+  s_haveConjecture=parser.containsConjecture();
+  includedFiles().reset();
+  includedFiles().loadFromIterator(StringStack::BottomFirstIterator(parser.includedFiles()));
+  return parser.units();
+}
+
+/**
+ * Return the names of the files included by the last parsed TPTP problem
+ */
+StringStack& UIHelper::includedFiles()
+{
+  static StringStack files;
+  return files;
+}
+
 /**
  * Return problem object with units obtained according to the content of
  * @b env.options
@@ -211,10 +240,13 @@ Problem* UIHelper::getInputProblem(const Options& opts)
 
   vstring inputFile = opts.inputFile();
 
-  istream* input;
+  // TPTP files are mapped into memory by the parser
+  bool parserOpensFile = inputFile!="" && opts.inputSyntax()==Options::InputSyntax::TPTP;
+
+  istream* input=0;
   if (inputFile=="") {
     input=&cin;
-  } else {
+  } else if (!parserOpensFile) {
     // CAREFUL: this might not be enough if the ifstream (re)allocates while being operated
     BYPASSING_ALLOCATOR; 
     
@@ -236,17 +268,13 @@ Problem* UIHelper::getInputProblem(const Options& opts)
   }
   break;
   case Options::InputSyntax::TPTP:
-    {
+    if (parserOpensFile) {
+      Parse::TPTP parser(inputFile);
+      units = parseTPTP(parser);
+    }
+    else {
       Parse::TPTP parser(*input);
-      try{
-        parser.parse();
-      }
-      catch (UserErrorException& exception) {
-        vstring msg = exception.msg();
-        throw Parse::TPTP::ParseErrorException(msg,parser.lineNumber());
-      }
-      units = parser.units();
-      s_haveConjecture=parser.containsConjecture();
+      units = parseTPTP(parser);
     }
     break;
   case Options::InputSyntax::SMTLIB:
@@ -287,7 +315,7 @@ Problem* UIHelper::getInputProblem(const Options& opts)
    break;
   }
 
-  if (inputFile!="") {
+  if (inputFile!="" && !parserOpensFile) {
     BYPASSING_ALLOCATOR;
     
     delete static_cast<ifstream*>(input);
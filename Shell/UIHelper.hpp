@@ -29,6 +29,10 @@
 #include "Forwards.hpp"
 #include "Options.hpp"
 
+namespace Parse {
+class TPTP;
+}
+
 namespace Shell {
 
 using namespace Lib;
@@ -54,6 +58,7 @@ public:
    */
   static bool haveConjecture() { return s_haveConjecture; }
   static void setConjecturePresence(bool haveConjecture) { s_haveConjecture=haveConjecture; }
+  static StringStack& includedFiles();
 
   static void outputAllPremises(ostream& out, UnitList* units, vstring prefix="");
 
@@ -78,6 +83,7 @@ public:
   static bool satisfiableStatusWasAlreadyOutput;
 
 private:
+  static UnitList* parseTPTP(Parse::TPTP& parser);
 
   static bool s_haveConjecture;
 #if VDEBUG
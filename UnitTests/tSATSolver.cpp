@@ -27,6 +27,7 @@
 #include "SAT/SATSolver.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/Z3Interfacing.hpp"
 
 #include "Test/UnitTesting.hpp"
@@ -244,6 +245,10 @@ TEST_FUN(testSATSolverInterface)
   TWLSolver sTWL(*env.options,true);
   testInterface(sTWL);  
 
+  cout << endl << "Lingeling" << endl;
+  LingelingInterfacing sLgl(*env.options,true);
+  testInterface(sLgl);
+
   /* Not fully conforming - does not support zeroImplied and resource-limited solving
   cout << endl << "Z3" << endl;
   {
@@ -308,6 +313,10 @@ TEST_FUN(testSolvingUnderAssumptions)
   TWLSolver sTWL(*env.options,true);
   testAssumptions(sTWL);
 
+  cout << endl << "Lingeling" << endl;
+  LingelingInterfacing sLgl(*env.options,true);
+  testAssumptions(sLgl);
+
   /*cout << endl << "Z3" << endl;
   {
     SAT2FO sat2fo;
@@ -66,6 +66,7 @@
 #include "SAT/DIMACS.hpp"
 
 #include "CASC/PortfolioMode.hpp"
+#include "CASC/SATPortfolioMode.hpp"
 #include "CASC/CLTBMode.hpp"
 #include "CASC/CLTBModeLearning.hpp"
 #include "Shell/CParser.hpp"
@@ -77,6 +78,7 @@
 #include "Shell/Property.hpp"
 #include "Saturation/ProvingHelper.hpp"
 #include "Shell/Preprocess.hpp"
+#include "Shell/ProblemCache.hpp"
 #include "Shell/Refutation.hpp"
 #include "Shell/TheoryFinder.hpp"
 #include "Shell/TPTPPrinter.hpp"
@@ -89,6 +91,7 @@
 #include "Saturation/SaturationAlgorithm.hpp"
 
 #include "SAT/MinisatInterfacing.hpp"
+#include "SAT/LingelingInterfacing.hpp"
 #include "SAT/MinisatInterfacingNewSimp.hpp"
 #include "SAT/TWLSolver.hpp"
 #include "SAT/Preprocess.hpp"
@@ -160,6 +163,15 @@ Problem* getPreprocessedProblem()
 {
   CALL("getPreprocessedProblem");
 
+  vstring cacheFile = env.options->problemCache();
+  if (cacheFile != "") {
+    TimeCounter tc(TC_PARSING);
+    Problem* prb = ProblemCache::load(cacheFile);
+    if (prb) {
+      return prb;
+    }
+  }
+
   Problem* prb = UIHelper::getInputProblem(*env.options);
 
   TimeCounter tc2(TC_PREPROCESSING);
@@ -167,6 +179,10 @@ Problem* getPreprocessedProblem()
   Shell::Preprocess prepro(*env.options);
   //phases for preprocessing are being set inside the preprocess method
   prepro.preprocess(*prb);
+
+  if (cacheFile != "") {
+    ProblemCache::save(cacheFile, *prb);
+  }
   
   // TODO: could this be the right way to freeing the currently leaking classes like Units, Clauses and Inferences?
   // globUnitList = prb->units();
@@ -543,19 +559,6 @@ void satSolverMode()
 {
   CALL("satSolverMode()");
   TimeCounter tc(TC_SAT_SOLVER);
-  SATSolverSCP solver;
-  
-  switch(env.options->satSolver()) {
-    case Options::SatSolver::VAMPIRE:  
-      solver = new TWLSolver(*env.options);
-      break;
-    case Options::SatSolver::MINISAT:
-      solver = new MinisatInterfacingNewSimp(*env.options);
-      break;      
-    default:
-      ASSERTION_VIOLATION(env.options->satSolver());
-  }
-    
   //get the clauses; 
   SATClauseList* clauses;
   unsigned varCnt=0;
@@ -564,10 +567,32 @@ void satSolverMode()
   
   clauses = getInputClauses(env.options->inputFile().c_str(), varCnt);
   
-  solver->ensureVarCount(varCnt);
-  solver->addClausesIter(preprocessClauses(clauses));
+  if(env.options->multicore()!=1) {
+    SATClauseList* preprocessed = 0;
+    SATClauseList::pushFromIterator(preprocessClauses(clauses), preprocessed);
+    res = CASC::SATPortfolioMode::solve(preprocessed, varCnt);
+  }
+  else {
+    SATSolverSCP solver;
+    switch(env.options->satSolver()) {
+      case Options::SatSolver::VAMPIRE:
+        solver = new TWLSolver(*env.options);
+        break;
+      case Options::SatSolver::MINISAT:
+        solver = new MinisatInterfacingNewSimp(*env.options);
+        break;
+      case Options::SatSolver::LINGELING:
+        solver = new LingelingInterfacing(*env.options);
+        break;
+      default:
+        ASSERTION_VIOLATION(env.options->satSolver());
+    }
+
+    solver->ensureVarCount(varCnt);
+    solver->addClausesIter(preprocessClauses(clauses));
 
-  res = solver->solve();
+    res = solver->solve();
+  }
 
   env.statistics->phase = Statistics::FINALIZATION;
 